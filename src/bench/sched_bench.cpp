@@ -0,0 +1,106 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+// Mirror the scheduler's event layout so both queues move the same amount of data
+struct Event {
+    uint32_t task;
+    uint64_t cycles;
+    uint64_t order;
+
+    Event(uint32_t task, uint64_t cycles, uint64_t order): task(task), cycles(cycles), order(order) {}
+    bool operator<(const Event &event) const { return cycles < event.cycles; }
+    bool operator>(const Event &event) const
+        { return cycles > event.cycles || (cycles == event.cycles && order > event.order); }
+};
+
+struct SortedQueue {
+    std::vector<Event> events;
+
+    void push(Event event) { events.insert(std::upper_bound(events.begin(), events.end(), event), event); }
+    Event pop() { Event event = events[0]; events.erase(events.begin()); return event; }
+};
+
+struct HeapQueue {
+    std::vector<Event> events;
+
+    void push(Event event) {
+        events.push_back(event);
+        std::push_heap(events.begin(), events.end(), std::greater<Event>());
+    }
+
+    Event pop() {
+        Event event = events[0];
+        std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+        events.pop_back();
+        return event;
+    }
+};
+
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+    // Generate delays with a small xorshift so both queues see the same sequence
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+template <typename Queue> double run(uint32_t size, uint32_t count, uint64_t &check) {
+    // Fill the queue to a steady size, with a far-off task at the end like the cycle reset
+    Queue queue;
+    uint64_t now = 0, order = 0;
+    rng = 1;
+    queue.push(Event(0, 0x7FFFFFFFFFFFFFFF, order++));
+    for (uint32_t i = 1; i < size; i++)
+        queue.push(Event(i, nextRandom() & 0xFFFF, order++));
+
+    // Fire the soonest task and schedule it again, as devices do from their task handlers
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        Event event = queue.pop();
+        now = event.cycles;
+        check += event.task;
+        queue.push(Event(event.task, now + (nextRandom() & 0xFFFF), order++));
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+    // Time pop+push pairs for each queue at a range of pending task counts
+    uint32_t count = (argc > 1) ? atoi(argv[1]) : 10000000;
+    static const uint32_t sizes[] = { 4, 8, 16, 32, 64, 128, 512 };
+    printf("pending  sorted (ns/op)  heap (ns/op)\n");
+    for (uint32_t size : sizes) {
+        uint64_t check = 0;
+        double sorted = run<SortedQueue>(size, count, check);
+        double heap = run<HeapQueue>(size, count, check);
+        printf("%7u  %14.2f  %12.2f  (%llu)\n", size, sorted * 1e9 / count, heap * 1e9 / count,
+            (unsigned long long)(check & 0xFFFF));
+    }
+    return 0;
+}
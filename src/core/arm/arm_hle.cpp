@@ -0,0 +1,166 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include "../core.h"
+
+// Number of code bytes hashed at the start of a routine to fingerprint it
+#define HASH_SIZE 64
+
+// Names used for routines in the fingerprint list, indexed by kind
+static const char *hleNames[] = { "", "memcpy", "memmove", "memset", "__aeabi_memset", "__aeabi_memclr", "memcmp" };
+
+ArmHle::ArmHle(Core &core, ArmInterp &cpu): core(core), cpu(cpu) {
+    // Load routine fingerprints if the list exists, with a hex hash and routine name on each line
+    FILE *file = fopen((Settings::basePath + "/hle.txt").c_str(), "r");
+    if (!file) return;
+    char name[32];
+    uint32_t hash;
+    while (fscanf(file, "%x %31s", &hash, name) == 2) {
+        for (int i = HLE_MEMCPY; i <= HLE_MEMCMP; i++)
+            if (!strcmp(name, hleNames[i])) routines[hash] = HleKind(i);
+    }
+    fclose(file);
+}
+
+int ArmHle::checkCall(int cost) {
+    // Get a host pointer to the call target, leaving unmapped code to the interpreter
+    bool thumb = (cpu.cpsr & BIT(5));
+    uint32_t address = cpu.registers[15] - (thumb ? 2 : 4);
+    uint8_t *host = core.cp15.getReadPtr(cpu.id, address);
+    if (!host) return cost;
+    host += (address & 0xFFF);
+
+    // Look up what the target is, and fingerprint it again if its page was written since
+    HleEntry &entry = entries[uintptr_t(host) | thumb];
+    if (!entry.memTag || *entry.memTag != entry.tag) {
+        entry.memTag = core.cp15.getMemTag(cpu.id, address);
+        entry.tag = *entry.memTag;
+        entry.kind = identify(address, host);
+    }
+
+    // Perform a known routine natively, or interpret it if its arguments reach outside direct memory
+    uint32_t *regs = cpu.registers;
+    int cycles;
+    switch (entry.kind) {
+        case HLE_MEMCPY: cycles = memCopy(regs[0], regs[1], regs[2]); break;
+        case HLE_MEMMOVE: cycles = memMove(regs[0], regs[1], regs[2]); break;
+        case HLE_MEMSET: cycles = memSet(regs[0], regs[1], regs[2]); break;
+        case HLE_MEMSET_AEABI: cycles = memSet(regs[0], regs[2], regs[1]); break;
+        case HLE_MEMCLR: cycles = memSet(regs[0], 0, regs[1]); break;
+        case HLE_MEMCMP: cycles = memCmp(regs[0], regs[1], regs[2]); break;
+        default: return cost;
+    }
+    if (!cycles) return cost;
+
+    // Return to the caller as if the routine ended with BX LR
+    cpu.cpsr = (cpu.cpsr & ~BIT(5)) | ((regs[14] & BIT(0)) << 5);
+    regs[15] = regs[14];
+    cpu.flushPipeline();
+    return cost + cycles;
+}
+
+HleKind ArmHle::identify(uint32_t address, uint8_t *host) {
+    // Hash the start of a routine with FNV-1a if it fits in the page, and look it up in the fingerprint list
+    if (routines.empty() || (address & 0xFFF) > 0x1000 - HASH_SIZE) return HLE_NONE;
+    uint32_t hash = 0x811C9DC5;
+    for (int i = 0; i < HASH_SIZE; i++)
+        hash = (hash ^ host[i]) * 0x1000193;
+    std::unordered_map<uint32_t, HleKind>::iterator it = routines.find(hash);
+    if (it == routines.end()) return HLE_NONE;
+    LOG_INFO("Replacing %s at 0x%X on ARM11 core %d with native code\n", hleNames[it->second], address, cpu.id);
+    return it->second;
+}
+
+uint8_t *ArmHle::getPtr(uint32_t address, bool write) {
+    // Get a direct pointer to guest memory, adjusting the page tag if it's for writing
+    uint8_t *data = write ? core.cp15.getWritePtr(cpu.id, address) : core.cp15.getReadPtr(cpu.id, address);
+    return data ? (data + (address & 0xFFF)) : nullptr;
+}
+
+bool ArmHle::checkRange(uint32_t address, uint32_t size, bool write) {
+    // Check that every page in a range has a direct pointer, so operations never fail partway
+    if (!size) return true;
+    uint32_t end = address + size - 1;
+    if (end < address) return false;
+    for (uint32_t page = (address >> 12); page <= (end >> 12); page++)
+        if (!getPtr(page << 12, write)) return false;
+    return true;
+}
+
+int ArmHle::memCopy(uint32_t dst, uint32_t src, uint32_t size) {
+    // Copy forward in chunks that stay within a page on both sides
+    if (!checkRange(src, size, false) || !checkRange(dst, size, true)) return 0;
+    for (uint32_t i = 0; i < size;) {
+        uint32_t len = std::min(size - i, 0x1000 - std::max((src + i) & 0xFFF, (dst + i) & 0xFFF));
+        memmove(getPtr(dst + i, true), getPtr(src + i, false), len);
+        i += len;
+    }
+
+    // Estimate the cost of a word-based copy loop
+    return 8 + (size >> 1);
+}
+
+int ArmHle::memMove(uint32_t dst, uint32_t src, uint32_t size) {
+    // Copy forward unless the destination overlaps the end of the source
+    if (dst <= src || dst - src >= size)
+        return memCopy(dst, src, size);
+
+    // Copy backward in chunks that stay within a page on both sides
+    if (!checkRange(src, size, false) || !checkRange(dst, size, true)) return 0;
+    for (uint32_t i = size; i > 0;) {
+        uint32_t len = std::min(i, std::min((src + i - 1) & 0xFFF, (dst + i - 1) & 0xFFF) + 1);
+        i -= len;
+        memmove(getPtr(dst + i, true), getPtr(src + i, false), len);
+    }
+    return 8 + (size >> 1);
+}
+
+int ArmHle::memSet(uint32_t dst, uint8_t value, uint32_t size) {
+    // Fill in chunks that stay within a page
+    if (!checkRange(dst, size, true)) return 0;
+    for (uint32_t i = 0; i < size;) {
+        uint32_t len = std::min(size - i, 0x1000 - ((dst + i) & 0xFFF));
+        memset(getPtr(dst + i, true), value, len);
+        i += len;
+    }
+
+    // Estimate the cost of a block store loop
+    return 8 + (size >> 3);
+}
+
+int ArmHle::memCmp(uint32_t ptr1, uint32_t ptr2, uint32_t size) {
+    // Compare in chunks that stay within a page on both sides
+    if (!checkRange(ptr1, size, false) || !checkRange(ptr2, size, false)) return 0;
+    cpu.registers[0] = 0;
+    for (uint32_t i = 0; i < size;) {
+        uint32_t len = std::min(size - i, 0x1000 - std::max((ptr1 + i) & 0xFFF, (ptr2 + i) & 0xFFF));
+        uint8_t *data1 = getPtr(ptr1 + i, false), *data2 = getPtr(ptr2 + i, false);
+        if (memcmp(data1, data2, len)) {
+            // Return the difference of the first mismatched bytes, charging only for what was compared
+            uint32_t j = 0;
+            while (data1[j] == data2[j]) j++;
+            cpu.registers[0] = data1[j] - data2[j];
+            return 8 + i + j;
+        }
+        i += len;
+    }
+    return 8 + size;
+}
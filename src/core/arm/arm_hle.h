@@ -0,0 +1,67 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include "../defines.h"
+
+class ArmInterp;
+class Core;
+
+enum HleKind {
+    HLE_NONE,
+    HLE_MEMCPY, // r0 = dst, r1 = src, r2 = size
+    HLE_MEMMOVE, // r0 = dst, r1 = src, r2 = size
+    HLE_MEMSET, // r0 = dst, r1 = value, r2 = size
+    HLE_MEMSET_AEABI, // r0 = dst, r1 = size, r2 = value
+    HLE_MEMCLR, // r0 = dst, r1 = size
+    HLE_MEMCMP // r0 = ptr1, r1 = ptr2, r2 = size
+};
+
+struct HleEntry {
+    uint32_t *memTag;
+    uint32_t tag;
+    HleKind kind;
+};
+
+class ArmHle {
+public:
+    ArmHle(Core &core, ArmInterp &cpu);
+
+    int checkCall(int cost);
+    void reset() { entries.clear(); }
+
+private:
+    Core &core;
+    ArmInterp &cpu;
+
+    std::unordered_map<uint32_t, HleKind> routines;
+    std::unordered_map<uintptr_t, HleEntry> entries;
+
+    HleKind identify(uint32_t address, uint8_t *host);
+    uint8_t *getPtr(uint32_t address, bool write);
+    bool checkRange(uint32_t address, uint32_t size, bool write);
+
+    int memCopy(uint32_t dst, uint32_t src, uint32_t size);
+    int memMove(uint32_t dst, uint32_t src, uint32_t size);
+    int memSet(uint32_t dst, uint8_t value, uint32_t size);
+    int memCmp(uint32_t ptr1, uint32_t ptr2, uint32_t size);
+};
@@ -17,19 +17,26 @@
     along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <thread>
 #include "arm_interp.h"
+#include "arm_interp_ops.h"
 #include "../core.h"
+#include "../dispatch.h"
 
 template void ArmInterp::runFrame<false, false>(Core&);
 template void ArmInterp::runFrame<false, true>(Core&);
 template void ArmInterp::runFrame<true, false>(Core&);
 template void ArmInterp::runFrame<true, true>(Core&);
+template void ArmInterp::runFrameBatch<false, false>(Core&);
+template void ArmInterp::runFrameBatch<false, true>(Core&);
+template void ArmInterp::runFrameBatch<true, false>(Core&);
+template void ArmInterp::runFrameBatch<true, true>(Core&);
+template void ArmInterp::runFrameThreaded<false, false>(Core&);
+template void ArmInterp::runFrameThreaded<false, true>(Core&);
+template void ArmInterp::runFrameThreaded<true, false>(Core&);
+template void ArmInterp::runFrameThreaded<true, true>(Core&);
 
 ArmInterp::ArmInterp(Core &core, CpuId id): core(core), id(id) {
-    // Initialize the registers for user mode
-    for (int i = 0; i < 32; i++)
-        registers[i] = &registersUsr[i & 0xF];
-
     // Don't start extra ARM11 cores right away
     if (id == ARM11C || id == ARM11D)
         halt(BIT(0));
@@ -38,10 +45,57 @@ ArmInterp::ArmInterp(Core &core, CpuId id): core(core), id(id) {
 void ArmInterp::init() {
     // Prepare to execute the boot ROM
     setCpsr(0xD3); // Supervisor, interrupts off
-    registersUsr[15] = (id == ARM9) ? 0xFFFF0000 : 0x10000;
+    registers[15] = (id == ARM9) ? 0xFFFF0000 : 0x10000;
     flushPipeline();
 }
 
+void ArmInterp::serialize(SaveState &s) {
+    // Transfer the CPU registers and execution state, with the pipeline filled if blocks left it stale
+    // Active registers are written to their banks first so the saved layout doesn't depend on the mode
+    if (!s.loading) {
+        refillPipeline();
+        updateFlags();
+        for (int i = 0; i < 16; i++)
+            *bankRegister(cpsr & 0x1F, i) = registers[i];
+    }
+    uint32_t value = cpsr;
+    s.io(value);
+    s.io(registersUsr);
+    s.io(registersFiq);
+    s.io(registersSvc);
+    s.io(registersAbt);
+    s.io(registersIrq);
+    s.io(registersUnd);
+    s.io(spsrFiq);
+    s.io(spsrSvc);
+    s.io(spsrAbt);
+    s.io(spsrIrq);
+    s.io(spsrUnd);
+    s.io(pipeline);
+    s.io(cycles);
+    s.io(excValue);
+    s.io(excAddress);
+    s.io(exclusive);
+    s.io(event);
+    s.io(halted);
+    s.io(spinRegs);
+    s.io(spinCpsr);
+    s.io(spinPc);
+    s.io(spinCycles);
+    s.io(spinType);
+    if (!s.loading) return;
+
+    // Load the user registers and force a mode change to swap in banked ones, then drop cached code state
+    for (int i = 0; i < 16; i++)
+        registers[i] = registersUsr[i];
+    cpsr = 0;
+    setCpsr(value);
+    invalidatePc();
+    pipeStale = false;
+    if (jit) jit->reset();
+    if (hle) hle->reset();
+}
+
 void ArmInterp::resetCycles() {
     // Adjust CPU cycles for a global cycle reset
     if (cycles != -1)
@@ -88,53 +142,317 @@ template <bool cores, bool dsp> void ArmInterp::runFrame(Core &core) {
         }
 
         // Jump to the next task and run all that are scheduled now
-        core.globalCycles = core.events[0].cycles;
-        while (core.events[0].cycles <= core.globalCycles) {
-            (*core.events[0].task)();
-            core.events.erase(core.events.begin());
+        core.runEvents();
+    }
+}
+
+template <bool cores, bool dsp> void ArmInterp::runFrameBatch(Core &core) {
+    // Run a frame of CPU instructions and events, with each CPU running a slice at a time
+    while (core.running.exchange(true)) {
+        // Run the CPUs in slices until the next scheduled task
+        while (core.events[0].cycles > core.globalCycles) {
+            // Limit the slice to the quantum or the next scheduled task
+            uint64_t start = core.globalCycles;
+            uint64_t end = std::min(core.events[0].cycles, start + core.cpuQuantum);
+
+            // Run 2 or 4 ARM11 cores depending on what's enabled
+            for (int i = 0; i < (cores ? 4 : 2); i++)
+                core.arms[i].runSlice(start, end, 0);
+
+            // Run the ARM9 at half the speed of the ARM11
+            core.arms[ARM9].runSlice(start, end, 1);
+
+            // Handle the DSP CPU if it's enabled
+            if (dsp) {
+                // Run the Teak and jump to the next soonest ARM9 or Teak cycle
+                TeakInterp &teak = ((DspLle*)core.dsp)->teak;
+                teak.runSlice(start, end);
+                core.globalCycles = std::min(core.arms[ARM9].cycles, teak.cycles);
+            }
+            else {
+                // Jump to the next soonest ARM9 cycle
+                core.globalCycles = core.arms[ARM9].cycles;
+            }
+
+            // Jump to the next soonest ARM11 cycle if it's closer
+            for (int i = 0; i < (cores ? 4 : 2); i++)
+                core.globalCycles = std::min(core.globalCycles, core.arms[i].cycles);
         }
+
+        // Jump to the next task and run all that are scheduled now
+        core.runEvents();
+    }
+}
+
+template <bool cores, bool dsp> void ArmInterp::runFrameThreaded(Core &core) {
+    // Claim the CPUs without their own host threads for this one, and count the threads that run slices
+    TeakInterp *teak = dsp ? &((DspLle*)core.dsp)->teak : nullptr;
+    uint8_t mask = 0;
+    uint32_t count = 0;
+    for (int i = 0; i < MAX_CPUS; i++) {
+        if (!core.threads[i])
+            core.arms[i].threadId = std::this_thread::get_id();
+        else if (i < (cores ? 4 : 2) || i == ARM9)
+            mask |= BIT(i), count++;
+    }
+
+    // Hand the Teak to its host thread if it's enabled
+    if (dsp && core.threads[MAX_CPUS]) {
+        teak->threadId = core.threads[MAX_CPUS]->get_id();
+        mask |= BIT(MAX_CPUS), count++;
+    }
+
+    // Run a frame of CPU instructions and events
+    while (core.running.exchange(true)) {
+        // Run the CPUs in slices until the next scheduled task
+        while (core.events[0].cycles > core.globalCycles) {
+            // Limit the slice to the quantum or the next scheduled task
+            uint64_t start = core.globalCycles;
+            uint64_t end = std::min(core.events[0].cycles, start + core.cpuQuantum);
+
+            // Signal the host threads to run a slice
+            core.sliceStart = start;
+            core.sliceEnd = end;
+            core.sliceLeft.store(count);
+            core.slicing.store(true);
+            core.sliceCount++;
+            for (int i = 0; i <= MAX_CPUS; i++)
+                if (mask & BIT(i)) core.sliceIds[i].store(core.sliceCount);
+            notifyThreads(core);
+
+            // Run the CPUs that don't have their own threads, leaving shared time at the start of the slice
+            for (int i = 0; i < (cores ? 4 : 2); i++)
+                if (!core.threads[i]) core.arms[i].runSliceThreaded(start, end, 0);
+            if (!core.threads[ARM9])
+                core.arms[ARM9].runSliceThreaded(start, end, 1);
+            if (dsp && !core.threads[MAX_CPUS])
+                teak->runSliceThreaded(start, end);
+
+            // Wait for the host threads to reach the end of the slice
+            waitThreads(core, [&core] { return !core.sliceLeft.load(); });
+            core.slicing.store(false);
+
+            // Jump to the next soonest CPU cycle
+            core.globalCycles = core.arms[ARM9].cycles;
+            if (dsp) core.globalCycles = std::min(core.globalCycles, teak->cycles);
+            for (int i = 0; i < (cores ? 4 : 2); i++)
+                core.globalCycles = std::min(core.globalCycles, core.arms[i].cycles);
+
+            // Apply events and unhalts that were sent between threads during the slice
+            for (int i = 0; i < MAX_CPUS; i++)
+                core.arms[i].applyWakeups();
+        }
+
+        // Jump to the next task and run all that are scheduled now
+        core.runEvents();
+    }
+
+    // Apply anything that was sent to the Teak thread after its last slice
+    if (dsp && core.threads[MAX_CPUS]) {
+        teak->threadId = std::thread::id();
+        teak->checkMail();
+    }
+}
+
+void ArmInterp::startThreads(Core &core) {
+    // Start host threads once for CPUs that run separately, which stay parked between slices and frames
+    bool enabled[] = { false, core.threadedArm11, core.threadedArm11, core.threadedArm11, core.threadedArm9, core.threadedDsp };
+    for (int i = 0; i <= MAX_CPUS; i++) {
+        if (!enabled[i]) continue;
+        core.threads[i] = new std::thread(&ArmInterp::runThread, &core, i);
+        if (i < MAX_CPUS) core.arms[i].threadId = core.threads[i]->get_id();
+    }
+}
+
+void ArmInterp::stopThreads(Core &core) {
+    // Signal the host threads to finish and wait for them to exit
+    core.threadsStop = true;
+    for (int i = 0; i <= MAX_CPUS; i++)
+        core.sliceIds[i].fetch_add(1);
+    notifyThreads(core);
+    for (int i = 0; i <= MAX_CPUS; i++) {
+        if (!core.threads[i]) continue;
+        core.threads[i]->join();
+        delete core.threads[i];
+        core.threads[i] = nullptr;
+    }
+}
+
+void ArmInterp::runThread(Core *core, int i) {
+    // Run slices for an ARM core, or for the Teak if past the ARM range, as they're signaled
+    uint32_t id = 0;
+    while (true) {
+        // Wait for the next slice or finish if stopped
+        waitThreads(*core, [core, i, id] { return core->sliceIds[i].load() != id; });
+        id = core->sliceIds[i].load();
+        if (core->threadsStop) return;
+
+        // Run the slice and report back, waking the main thread if this was the last one
+        if (i < MAX_CPUS)
+            core->arms[i].runSliceThreaded(core->sliceStart, core->sliceEnd, (i == ARM9) ? 1 : 0);
+        else
+            ((DspLle*)core->dsp)->teak.runSliceThreaded(core->sliceStart, core->sliceEnd);
+        if (core->sliceLeft.fetch_sub(1) == 1)
+            notifyThreads(*core);
     }
 }
 
+template <typename T> void ArmInterp::waitThreads(Core &core, T ready) {
+    // Spin briefly since slices are short, then sleep until another thread makes progress
+    for (int i = 0; i < 1000; i++)
+        if (ready()) return;
+    std::unique_lock<std::mutex> lock(core.threadMutex);
+    core.threadsWaiting.fetch_add(1);
+    core.threadCond.wait(lock, ready);
+    core.threadsWaiting.fetch_sub(1);
+}
+
+void ArmInterp::notifyThreads(Core &core) {
+    // Wake sleeping threads, taking the mutex so one that's about to sleep can't miss it
+    if (!core.threadsWaiting.load()) return;
+    core.threadMutex.lock();
+    core.threadMutex.unlock();
+    core.threadCond.notify_all();
+}
+
+FORCE_INLINE void ArmInterp::runSlice(uint64_t start, uint64_t &end, uint8_t shift) {
+    // Catch up a CPU that was unhalted during the previous slice
+    cycles = std::max(cycles, start);
+
+    // Run instructions until the end of the slice, tracking local time so tasks are scheduled correctly
+    // Blocks are run through the JIT when possible, which updates local and shared time itself
+#if COMPUTED_GOTO
+    if (!jit) return runDispatch<true>(end, shift);
+#endif
+    while (cycles < end) {
+        core.globalCycles = cycles;
+        if (!jit || !jit->runBlock())
+            cycles += (runOpcode() << shift);
+        end = std::min(end, core.nextEvent.load(std::memory_order_relaxed));
+    }
+}
+
+void ArmInterp::runSliceThreaded(uint64_t start, uint64_t end, uint8_t shift) {
+    // Run instructions until the end of the slice, the next scheduled task, or until halted
+    // Shared time is left at the start of the slice, since other CPUs are running in parallel
+    cycles = std::max(cycles, start);
+#if COMPUTED_GOTO
+    if (!jit) return runDispatch<false>(end, shift);
+#endif
+    while (cycles < end && !halted) {
+        if (!jit || !jit->runBlock())
+            cycles += (runOpcode() << shift);
+        end = std::min(end, core.nextEvent.load(std::memory_order_relaxed));
+    }
+}
+
+#if COMPUTED_GOTO
+// Pair each listed handler with its label in the dispatch loop
+#define ARM_LABEL(name) { &ArmInterp::name, &&ARM_##name },
+#define THUMB_LABEL(name) { &ArmInterp::name, &&THUMB_##name },
+
+// Define a label that runs an ARM or THUMB handler directly, then dispatches the next instruction
+#define ARM_HANDLER(name) ARM_##name: cycles += (COUNT_OP(armStats[index], opcode, name(opcode)) << shift); ARM_DISPATCH()
+#define THUMB_HANDLER(name) THUMB_##name: cycles += (COUNT_OP(thumbStats[index], opcode, name(opcode)) << shift); ARM_DISPATCH()
+
+// Check the end of the slice, then fetch an instruction and jump to its handler like in runOpcode
+// This is expanded after every handler, giving each its own indirect branch for the host to predict
+#define ARM_DISPATCH() \
+    end = std::min(end, core.nextEvent.load(std::memory_order_relaxed)); \
+    if (cycles >= end || (!shared && halted)) return; \
+    if (shared) core.globalCycles = cycles; \
+    opcode = pipeline[0]; \
+    instructions++; \
+    pipeline[0] = pipeline[1]; \
+    if (cpsr & BIT(5)) { \
+        pipeline[1] = (((registers[15] += 2) & 0xFFE) && pcData) ? U8TO16(pcData += 2, 0) : getOpcode16(); \
+        index = (opcode >> 6) & 0x3FF; \
+        goto *thumbLabels[index]; \
+    } \
+    pipeline[1] = (((registers[15] += 4) & 0xFFC) && pcData) ? U8TO32(pcData += 4, 0) : getOpcode32(); \
+    if ((opcode >> 28) != 0xE) updateFlags(); \
+    index = ((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0xF); \
+    switch (condition[((opcode >> 24) & 0xF0) | (cpsr >> 28)]) { \
+        case 0: goto armFalse; \
+        case 2: goto armReserved; \
+    } \
+    goto *armLabels[index];
+
+template <bool shared> void ArmInterp::runDispatch(uint64_t &end, uint8_t shift) {
+    // Map the lookup tables to handler labels once, since the tables remain the source of truth
+    static const OpLabel<int (ArmInterp::*)(uint32_t)> armOps[] = { ARM_OPS(ARM_LABEL) };
+    static const OpLabel<int (ArmInterp::*)(uint16_t)> thumbOps[] = { THUMB_OPS(THUMB_LABEL) };
+    static void **armLabels = mapLabels(armInstrs, 0x1000, armOps, sizeof(armOps) / sizeof(*armOps), &&armTable);
+    static void **thumbLabels = mapLabels(thumbInstrs, 0x400, thumbOps, sizeof(thumbOps) / sizeof(*thumbOps), &&thumbTable);
+
+    // Run instructions until the end of the slice, threading from handler to handler like runSlice
+    // Shared time and the task queue are only updated if other CPUs aren't running in parallel
+    uint32_t opcode;
+    uint16_t index;
+    ARM_DISPATCH()
+    ARM_OPS(ARM_HANDLER)
+    THUMB_OPS(THUMB_HANDLER)
+
+    // Handle instructions that fail their condition, reserved instructions, and unlisted handlers
+armFalse:
+    cycles += (1 << shift);
+    ARM_DISPATCH()
+armReserved:
+    cycles += (COUNT_OP(reservedStat, opcode, handleReserved(opcode)) << shift);
+    ARM_DISPATCH()
+armTable:
+    cycles += (COUNT_OP(armStats[index], opcode, (this->*armInstrs[index])(opcode)) << shift);
+    ARM_DISPATCH()
+thumbTable:
+    cycles += (COUNT_OP(thumbStats[index], opcode, (this->*thumbInstrs[index])(opcode)) << shift);
+    ARM_DISPATCH()
+}
+#endif
+
 FORCE_INLINE int ArmInterp::runOpcode() {
-    // Push the next opcode through the pipeline
+    // Push the next opcode through the pipeline and count it
     uint32_t opcode = pipeline[0];
+    instructions++;
     pipeline[0] = pipeline[1];
 
     // Execute an instruction
     if (cpsr & BIT(5)) { // THUMB mode
         // Increment the program counter and fill the pipeline from pointer or fallback
-        pipeline[1] = (((*registers[15] += 2) & 0xFFE) && pcData) ? U8TO16(pcData += 2, 0) : getOpcode16();
+        pipeline[1] = (((registers[15] += 2) & 0xFFE) && pcData) ? U8TO16(pcData += 2, 0) : getOpcode16();
 
         // Execute a THUMB instruction
-        return (this->*thumbInstrs[(opcode >> 6) & 0x3FF])(opcode);
+        uint16_t index = (opcode >> 6) & 0x3FF;
+        return COUNT_OP(thumbStats[index], opcode, (this->*thumbInstrs[index])(opcode));
     }
     else { // ARM mode
         // Increment the program counter and fill the pipeline from pointer or fallback
-        pipeline[1] = (((*registers[15] += 4) & 0xFFC) && pcData) ? U8TO32(pcData += 4, 0) : getOpcode32();
+        pipeline[1] = (((registers[15] += 4) & 0xFFC) && pcData) ? U8TO32(pcData += 4, 0) : getOpcode32();
 
-        // Execute an ARM instruction based on its condition
+        // Execute an ARM instruction based on its condition, resolving lazy flags unless it's always true
+        if ((opcode >> 28) != 0xE) updateFlags();
         switch (condition[((opcode >> 24) & 0xF0) | (cpsr >> 28)]) {
             case 0: return 1; // False
-            case 2: return handleReserved(opcode); // Reserved
-            default: return (this->*armInstrs[((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0xF)])(opcode);
+            case 2: return COUNT_OP(reservedStat, opcode, handleReserved(opcode)); // Reserved
+            default:
+                uint16_t index = ((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0xF);
+                return COUNT_OP(armStats[index], opcode, (this->*armInstrs[index])(opcode));
         }
     }
 }
 
 uint16_t ArmInterp::getOpcode16() {
     // Set the opcode pointer or fall back to a regular 16-bit opcode read
-    if (!(pcData = core.cp15.getReadPtr(id, *registers[15])))
-        return core.cp15.read<uint16_t>(id, *registers[15]);
-    pcData += (*registers[15] & 0xFFE);
+    if (!(pcData = core.cp15.getReadPtr(id, registers[15])))
+        return core.cp15.read<uint16_t>(id, registers[15]);
+    pcData += (registers[15] & 0xFFE);
     return U8TO16(pcData, 0);
 }
 
 uint32_t ArmInterp::getOpcode32() {
     // Set the opcode pointer or fall back to a regular 32-bit opcode read
-    if (!(pcData = core.cp15.getReadPtr(id, *registers[15])))
-        return core.cp15.read<uint32_t>(id, *registers[15]);
-    pcData += (*registers[15] & 0xFFC);
+    if (!(pcData = core.cp15.getReadPtr(id, registers[15])))
+        return core.cp15.read<uint32_t>(id, registers[15]);
+    pcData += (registers[15] & 0xFFC);
     return U8TO32(pcData, 0);
 }
 
@@ -147,6 +465,12 @@ void ArmInterp::halt(uint8_t mask) {
 }
 
 void ArmInterp::unhalt(uint8_t mask) {
+    // Leave the request for the main thread if the CPU is running a slice on another thread
+    if (core.slicing.load() && threadId != std::this_thread::get_id()) {
+        core.wakeups[id].fetch_or(mask);
+        return;
+    }
+
     // Clear a halt bit and enable the CPU if newly unhalted
     bool before = halted;
     halted &= ~mask;
@@ -154,105 +478,188 @@ void ArmInterp::unhalt(uint8_t mask) {
         cycles = 0;
 }
 
+void ArmInterp::sendEvent() {
+    // Leave the event for the main thread if the CPU is running a slice on another thread
+    if (core.slicing.load() && threadId != std::this_thread::get_id()) {
+        core.wakeups[id].fetch_or(BIT(7));
+        return;
+    }
+
+    // Unhalt the CPU if it's waiting for an event, or set its flag for the next one
+    if (halted & BIT(1))
+        unhalt(BIT(1));
+    else
+        event = true;
+}
+
+void ArmInterp::applyWakeups() {
+    // Apply an event and unhalts that were sent from other threads
+    if (!core.wakeups[id].load(std::memory_order_relaxed)) return;
+    uint8_t bits = core.wakeups[id].exchange(0);
+    if (bits & BIT(7)) sendEvent();
+    if (bits & 0x7F) unhalt(bits & 0x7F);
+}
+
 int ArmInterp::exception(uint8_t vector) {
     // Switch the CPU mode, save the return address, and jump to the exception vector
     static const uint8_t modes[] = { 0x13, 0x1B, 0x13, 0x17, 0x17, 0x13, 0x12, 0x11 };
+    updateFlags();
     setCpsr((cpsr & ~0x3F) | BIT(7) | modes[vector >> 2], true); // ARM, interrupts off, new mode
-    *registers[14] = *registers[15] + ((*spsr & BIT(5)) >> 4);
-    *registers[15] = core.cp15.exceptAddrs[id] + vector;
+    registers[14] = registers[15] + ((*spsr & BIT(5)) >> 4);
+    registers[15] = core.cp15.exceptAddrs[id] + vector;
     flushPipeline();
+
+    // Stop timing the current loop, since its next iteration includes the handler
+    spinCycles = -1;
     return 3;
 }
 
 void ArmInterp::flushPipeline() {
+    // Adjust the program counter after a jump, but leave the pipeline stale if running blocks that don't use it
+    if (jit) {
+        bool thumb = (cpsr & BIT(5));
+        registers[15] = (registers[15] & ~(thumb ? 0x1 : 0x3)) + (thumb ? 2 : 4);
+        pipeStale = true;
+        return;
+    }
+    fillPipeline();
+}
+
+void ArmInterp::refillPipeline() {
+    // Rewind the program counter to the last jump target and fill the pipeline if it was left stale
+    if (!pipeStale) return;
+    registers[15] -= (cpsr & BIT(5)) ? 2 : 4;
+    pipeStale = false;
+    fillPipeline();
+}
+
+void ArmInterp::fillPipeline() {
     // Adjust the program counter and refill the pipeline after a jump
     if (cpsr & BIT(5)) { // THUMB mode
-        pipeline[0] = core.cp15.read<uint16_t>(id, *registers[15] &= ~0x1);
-        *registers[15] += 2, pipeline[1] = getOpcode16();
+        pipeline[0] = core.cp15.read<uint16_t>(id, registers[15] &= ~0x1);
+        registers[15] += 2, pipeline[1] = getOpcode16();
     }
     else { // ARM mode
-        pipeline[0] = core.cp15.read<uint32_t>(id, *registers[15] &= ~0x3);
-        *registers[15] += 4, pipeline[1] = getOpcode32();
+        pipeline[0] = core.cp15.read<uint32_t>(id, registers[15] &= ~0x3);
+        registers[15] += 4, pipeline[1] = getOpcode32();
     }
 }
 
+int ArmInterp::checkSpin(int32_t offset, int cost) {
+    // Only consider short loops, and don't touch shared time when CPUs run on separate threads
+    if (offset < -0x48 || core.threadedArm11 || core.threadedArm9 || core.threadedDsp)
+        return cost;
+
+    // Start tracking a new loop, scanning it to see if it can be skipped
+    uint32_t target = registers[15] - ((cpsr & BIT(5)) ? 2 : 4);
+    if (target != spinPc) {
+        spinPc = target;
+        spinType = scanSpin(target, target - offset - ((cpsr & BIT(5)) ? 4 : 8));
+        spinCycles = -1;
+        return cost;
+    }
+    else if (!spinType) {
+        return cost;
+    }
+
+    // Check if the last iteration left every register unchanged, and snapshot them if not
+    uint64_t now = core.globalCycles;
+    updateFlags();
+    bool same = (spinCycles < now && spinCpsr == cpsr);
+    for (int i = 0; i < 15; i++) {
+        same &= (spinRegs[i] == registers[i]);
+        spinRegs[i] = registers[i];
+    }
+    uint64_t length = now - spinCycles;
+    spinCpsr = cpsr;
+    spinCycles = now;
+    if (!same) return cost;
+
+    // Ensure no other CPU is running, since it could change polled memory or send an interrupt before the next task
+    for (int i = 0; i < MAX_CPUS; i++)
+        if (i != id && core.arms[i].cycles != -1) return cost;
+    if (core.teakActive()) return cost;
+
+    // Fast-forward through whole iterations that would end before the next task, which gives the same result
+    uint8_t shift = (id == ARM9) ? 1 : 0;
+    uint64_t next = now + (cost << shift);
+    if (core.events[0].cycles <= next) return cost;
+    uint64_t count = std::min<uint64_t>((core.events[0].cycles - next) / length, 0x10000000 / length);
+    spinCycles += count * length;
+    return cost + ((count * length) >> shift);
+}
+
+uint8_t ArmInterp::scanSpin(uint32_t start, uint32_t end) {
+    // Check that a loop body only has register operations and loads without writeback
+    // Return 0 if it can't be skipped, 1 if it doesn't read memory, or 2 if it does
+    uint8_t type = 1;
+    if (cpsr & BIT(5)) { // THUMB mode
+        for (uint32_t addr = start; addr < end; addr += 2) {
+            uint16_t op = core.cp15.read<uint16_t>(id, addr);
+            if ((op >> 13) == 0x0 || (op >> 13) == 0x1 || (op >> 10) == 0x10) // Shift, immediate, and ALU
+                continue;
+            else if ((op >> 10) == 0x11 && ((op >> 8) & 0x3) != 0x3) // High register ALU
+                type = ((op & 0x87) == 0x87 && ((op >> 8) & 0x3) != 0x1) ? 0 : type;
+            else if ((op >> 11) == 0x09 || ((op >> 12) == 0x5 && ((op >> 9) & 0x7) >= 0x3) // PC-relative and register loads
+                || ((op >> 13) == 0x3 && (op & BIT(11))) || ((op >> 12) == 0x8 && (op & BIT(11))) // Immediate loads
+                || ((op >> 12) == 0x9 && (op & BIT(11)))) // SP-relative loads
+                type = 2;
+            else if ((op >> 12) == 0xA || (op >> 11) == 0x1C || ((op >> 12) == 0xD && ((op >> 8) & 0xF) < 0xE)) // Address and branches
+                continue;
+            else
+                return 0;
+            if (!type) return 0;
+        }
+    }
+    else { // ARM mode
+        for (uint32_t addr = start; addr < end; addr += 4) {
+            uint32_t op = core.cp15.read<uint32_t>(id, addr);
+            if ((op >> 28) == 0xF) // Unconditional
+                return 0;
+            else if ((op & 0x0E000090) == 0x00000090) // Extra loads and stores
+                type = ((op & 0x60) && (op & BIT(20)) && (op & 0x01200000) == 0x01000000 && ((op >> 12) & 0xF) != 0xF) ? 2 : 0;
+            else if ((op & 0x0C000000) == 0x00000000) // Data processing
+                type = ((op & 0x01900000) == 0x01000000 || ((op >> 12) & 0xF) == 0xF) ? 0 : type;
+            else if ((op & 0x0C000000) == 0x04000000) // Single loads and stores
+                type = ((op & 0x0E000010) != 0x06000010 && (op & BIT(20)) && (op & 0x01200000) == 0x01000000
+                    && ((op >> 12) & 0xF) != 0xF) ? 2 : 0;
+            else if ((op & 0x0F000000) != 0x0A000000) // Branches without link
+                return 0;
+            if (!type) return 0;
+        }
+    }
+    return type;
+}
+
 void ArmInterp::setCpsr(uint32_t value, bool save) {
-    // Swap banked registers if the CPU mode changed
+    // Resolve lazy flags so the old CPSR is complete before it gets saved or replaced
+    updateFlags();
+
+    // Swap banked registers between the active set and storage if the CPU mode changed
     if ((value & 0x1F) != (cpsr & 0x1F)) {
+        for (int i = 8; i < 15; i++) {
+            uint32_t *old = bankRegister(cpsr & 0x1F, i);
+            uint32_t *cur = bankRegister(value & 0x1F, i);
+            if (old == cur) continue;
+            *old = registers[i];
+            registers[i] = *cur;
+        }
+
+        // Point to the SPSR of the new mode
         switch (value & 0x1F) {
-        case 0x10: // User
-        case 0x1F: // System
-            registers[8] = &registersUsr[8];
-            registers[9] = &registersUsr[9];
-            registers[10] = &registersUsr[10];
-            registers[11] = &registersUsr[11];
-            registers[12] = &registersUsr[12];
-            registers[13] = &registersUsr[13];
-            registers[14] = &registersUsr[14];
-            spsr = nullptr;
-            break;
-
-        case 0x11: // FIQ
-            registers[8] = &registersFiq[0];
-            registers[9] = &registersFiq[1];
-            registers[10] = &registersFiq[2];
-            registers[11] = &registersFiq[3];
-            registers[12] = &registersFiq[4];
-            registers[13] = &registersFiq[5];
-            registers[14] = &registersFiq[6];
-            spsr = &spsrFiq;
-            break;
-
-        case 0x12: // IRQ
-            registers[8] = &registersUsr[8];
-            registers[9] = &registersUsr[9];
-            registers[10] = &registersUsr[10];
-            registers[11] = &registersUsr[11];
-            registers[12] = &registersUsr[12];
-            registers[13] = &registersIrq[0];
-            registers[14] = &registersIrq[1];
-            spsr = &spsrIrq;
-            break;
-
-        case 0x13: // Supervisor
-            registers[8] = &registersUsr[8];
-            registers[9] = &registersUsr[9];
-            registers[10] = &registersUsr[10];
-            registers[11] = &registersUsr[11];
-            registers[12] = &registersUsr[12];
-            registers[13] = &registersSvc[0];
-            registers[14] = &registersSvc[1];
-            spsr = &spsrSvc;
-            break;
-
-        case 0x17: // Abort
-            registers[8] = &registersUsr[8];
-            registers[9] = &registersUsr[9];
-            registers[10] = &registersUsr[10];
-            registers[11] = &registersUsr[11];
-            registers[12] = &registersUsr[12];
-            registers[13] = &registersAbt[0];
-            registers[14] = &registersAbt[1];
-            spsr = &spsrAbt;
-            break;
-
-        case 0x1B: // Undefined
-            registers[8] = &registersUsr[8];
-            registers[9] = &registersUsr[9];
-            registers[10] = &registersUsr[10];
-            registers[11] = &registersUsr[11];
-            registers[12] = &registersUsr[12];
-            registers[13] = &registersUnd[0];
-            registers[14] = &registersUnd[1];
-            spsr = &spsrUnd;
-            break;
-
-        default:
-            if (id == ARM9)
-                LOG_CRIT("Unknown ARM9 CPU mode: 0x%X\n", value & 0x1F);
-            else
-                LOG_CRIT("Unknown ARM11 core %d CPU mode: 0x%X\n", id, value & 0x1F);
-            break;
+            case 0x10: case 0x1F: spsr = nullptr; break; // User/System
+            case 0x11: spsr = &spsrFiq; break; // FIQ
+            case 0x12: spsr = &spsrIrq; break; // IRQ
+            case 0x13: spsr = &spsrSvc; break; // Supervisor
+            case 0x17: spsr = &spsrAbt; break; // Abort
+            case 0x1B: spsr = &spsrUnd; break; // Undefined
+
+            default:
+                if (id == ARM9)
+                    LOG_CRIT("Unknown ARM9 CPU mode: 0x%X\n", value & 0x1F);
+                else
+                    LOG_CRIT("Unknown ARM11 core %d CPU mode: 0x%X\n", id, value & 0x1F);
+                break;
         }
     }
 
@@ -262,6 +669,26 @@ void ArmInterp::setCpsr(uint32_t value, bool save) {
     core.interrupts.checkInterrupt(id);
 }
 
+uint32_t *ArmInterp::bankRegister(uint8_t mode, uint8_t i) {
+    // Get where a register is stored for a CPU mode while that mode isn't active
+    if (i < 8 || i == 15) return &registersUsr[i];
+    if (mode == 0x11) return &registersFiq[i - 8]; // FIQ
+    if (i < 13) return &registersUsr[i];
+    switch (mode) {
+        case 0x12: return &registersIrq[i - 13]; // IRQ
+        case 0x13: return &registersSvc[i - 13]; // Supervisor
+        case 0x17: return &registersAbt[i - 13]; // Abort
+        case 0x1B: return &registersUnd[i - 13]; // Undefined
+        default: return &registersUsr[i]; // User/System
+    }
+}
+
+uint32_t *ArmInterp::modeRegister(uint8_t mode, uint8_t i) {
+    // Get a register as seen from a CPU mode, which is the active one if the current mode shares it
+    uint32_t *bank = bankRegister(mode, i);
+    return (bank == bankRegister(cpsr & 0x1F, i)) ? &registers[i] : bank;
+}
+
 int ArmInterp::handleReserved(uint32_t opcode) {
     // Check for special opcodes that use the reserved condition code
     if ((opcode & 0xE000000) == 0xA000000)
@@ -296,3 +723,15 @@ int ArmInterp::unkThumb(uint16_t opcode) {
         LOG_CRIT("Unknown ARM11 core %d THUMB opcode: 0x%X\n", id, opcode);
     return 1;
 }
+
+#if OP_STATS
+void ArmInterp::writeOpStats(FILE *file, const char *name) {
+    // Write a report of the ARM and THUMB handlers that were executed, sorted by cycles
+    std::vector<OpGroup> groups;
+    groupOps(groups, "armInstrs", armStats, armInstrs, 0x1000);
+    groupOps(groups, "thumbInstrs", thumbStats, thumbInstrs, 0x400);
+    if (reservedStat.count)
+        groups.push_back({ "handleReserved", 0, reservedStat });
+    writeOps(file, name, groups);
+}
+#endif
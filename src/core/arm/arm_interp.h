@@ -20,27 +20,58 @@
 #pragma once
 
 #include <cstdint>
+#include <thread>
 #include "../defines.h"
+#include "../op_stats.h"
 
+class ArmHle;
+class ArmJit;
 class Core;
+class SaveState;
+
+enum FlagType {
+    FLAGS_NONE,
+    FLAGS_NZ,
+    FLAGS_ADD,
+    FLAGS_SUB
+};
 
 class ArmInterp {
 public:
+    friend class ArmHle;
+    friend class ArmJit;
+
     uint8_t halted = 0;
     uint32_t cpsr = 0;
-    uint32_t *registers[32] = {};
+    uint32_t registers[16] = {};
+    uint64_t instructions = 0;
+    ArmJit *jit = nullptr;
+    ArmHle *hle = nullptr;
+    std::thread::id threadId;
 
     ArmInterp(Core &core, CpuId id);
     void init();
+    void serialize(SaveState &s);
 
     void resetCycles();
     static void stopCycles(Core *core);
     template <bool cores, bool dsp> static void runFrame(Core &core);
+    template <bool cores, bool dsp> static void runFrameBatch(Core &core);
+    template <bool cores, bool dsp> static void runFrameThreaded(Core &core);
+    static void startThreads(Core &core);
+    static void stopThreads(Core &core);
 
     void halt(uint8_t mask);
     void unhalt(uint8_t mask);
+    void sendEvent();
+    void applyWakeups();
     int exception(uint8_t vector);
     void invalidatePc() { pcData = nullptr; }
+    void updateFlags();
+
+#if OP_STATS
+    void writeOpStats(FILE *file, const char *name);
+#endif
 
 private:
     Core &core;
@@ -60,14 +91,32 @@ private:
     uint32_t spsrIrq = 0;
     uint32_t spsrUnd = 0;
 
+    uint8_t flagType = FLAGS_NONE;
+    uint32_t flagRes = 0;
+    uint32_t flagOp1 = 0;
+    uint32_t flagOp2 = 0;
+
     uint8_t *pcData = nullptr;
     uint32_t pipeline[2] = {};
+    bool pipeStale = false;
     uint64_t cycles = 0;
     uint64_t excValue = 0;
     uint32_t excAddress = 0;
     bool exclusive = false;
     bool event = false;
 
+    uint32_t spinRegs[16] = {};
+    uint32_t spinCpsr = 0;
+    uint32_t spinPc = -1;
+    uint64_t spinCycles = 0;
+    uint8_t spinType = 0;
+
+#if OP_STATS
+    OpStat armStats[0x1000] = {};
+    OpStat thumbStats[0x400] = {};
+    OpStat reservedStat = {};
+#endif
+
     static int (ArmInterp::*armInstrs[0x1000])(uint32_t);
     static int (ArmInterp::*thumbInstrs[0x400])(uint16_t);
 
@@ -75,10 +124,30 @@ private:
     static const uint8_t bitCount[0x100];
 
     int runOpcode();
+    void runSlice(uint64_t start, uint64_t &end, uint8_t shift);
+    void runSliceThreaded(uint64_t start, uint64_t end, uint8_t shift);
+#if COMPUTED_GOTO
+    template <bool shared> void runDispatch(uint64_t &end, uint8_t shift);
+#endif
+    static void runThread(Core *core, int i);
+    template <typename T> static void waitThreads(Core &core, T ready);
+    static void notifyThreads(Core &core);
     uint16_t getOpcode16();
     uint32_t getOpcode32();
     void flushPipeline();
+    void refillPipeline();
+    void fillPipeline();
     void setCpsr(uint32_t value, bool save = false);
+    uint32_t *bankRegister(uint8_t mode, uint8_t i);
+    uint32_t *modeRegister(uint8_t mode, uint8_t i);
+    void loadBlock(uint32_t address, uint16_t list, uint8_t m);
+    void storeBlock(uint32_t address, uint16_t list, uint8_t m);
+    void resolveFlags();
+    void setFlagsNz(uint32_t res);
+    void setFlagsAdd(uint32_t op1, uint32_t op2, uint32_t res);
+    void setFlagsSub(uint32_t op1, uint32_t op2, uint32_t res);
+    int checkSpin(int32_t offset, int cost);
+    uint8_t scanSpin(uint32_t start, uint32_t end);
     int handleReserved(uint32_t opcode);
 
     int unkArm(uint32_t opcode);
@@ -871,3 +940,28 @@ private:
     int swiT(uint16_t opcode);
     int bkptT(uint16_t opcode);
 };
+
+FORCE_INLINE void ArmInterp::resolveFlags() {
+    // Compute the condition flags from the last flag-setting operation, keeping the others as they were
+    switch (flagType) {
+    case FLAGS_NZ:
+        cpsr = (cpsr & ~0xC0000000) | (flagRes & BIT(31)) | ((flagRes == 0) << 30);
+        break;
+
+    case FLAGS_ADD:
+        cpsr = (cpsr & ~0xF0000000) | (flagRes & BIT(31)) | ((flagRes == 0) << 30) | ((flagOp1 > flagRes) << 29) |
+            ((~(flagOp2 ^ flagOp1) & (flagRes ^ flagOp2) & BIT(31)) >> 3);
+        break;
+
+    case FLAGS_SUB:
+        cpsr = (cpsr & ~0xF0000000) | (flagRes & BIT(31)) | ((flagRes == 0) << 30) | ((flagOp1 >= flagRes) << 29) |
+            (((flagOp2 ^ flagOp1) & ~(flagRes ^ flagOp2) & BIT(31)) >> 3);
+        break;
+    }
+    flagType = FLAGS_NONE;
+}
+
+FORCE_INLINE void ArmInterp::updateFlags() {
+    // Resolve the condition flags only if an operation left them pending
+    if (flagType) resolveFlags();
+}
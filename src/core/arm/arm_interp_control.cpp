@@ -82,7 +82,7 @@ static const struct {
         log = log + " calling svc" + svcInfo[svc].name + "("; \
         for (int i = 0; i < svcInfo[svc].count; i++) { \
             char buf[11]; \
-            sprintf(buf, "0x%X", *registers[i]); \
+            sprintf(buf, "0x%X", registers[i]); \
             log = log + buf + ((i == svcInfo[svc].count - 1) ? "" : ", "); \
         } \
         LOG_OS("%s)\n", log.c_str()); \
@@ -96,54 +96,54 @@ static const struct {
 
 int ArmInterp::bx(uint32_t opcode) { // BX Rn
     // Branch to address and switch to THUMB if bit 0 is set
-    uint32_t op0 = *registers[opcode & 0xF];
+    uint32_t op0 = registers[opcode & 0xF];
     cpsr |= (op0 & BIT(0)) << 5;
-    *registers[15] = op0;
+    registers[15] = op0;
     flushPipeline();
     return 3;
 }
 
 int ArmInterp::blxReg(uint32_t opcode) { // BLX Rn
     // Branch to address with link and switch to THUMB if bit 0 is set
-    uint32_t op0 = *registers[opcode & 0xF];
+    uint32_t op0 = registers[opcode & 0xF];
     cpsr |= (op0 & BIT(0)) << 5;
-    *registers[14] = *registers[15] - 4;
-    *registers[15] = op0;
+    registers[14] = registers[15] - 4;
+    registers[15] = op0;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::b(uint32_t opcode) { // B label
     // Branch to offset
     int32_t op0 = (int32_t)(opcode << 8) >> 6;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bl(uint32_t opcode) { // BL label
     // Branch to offset with link
     int32_t op0 = (int32_t)(opcode << 8) >> 6;
-    *registers[14] = *registers[15] - 4;
-    *registers[15] += op0;
+    registers[14] = registers[15] - 4;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::blx(uint32_t opcode) { // BLX label
     // Branch to offset with link and switch to THUMB
     int32_t op0 = ((int32_t)(opcode << 8) >> 6) | ((opcode & BIT(24)) >> 23);
     cpsr |= BIT(5);
-    *registers[14] = *registers[15] - 4;
-    *registers[15] += op0;
+    registers[14] = registers[15] - 4;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::swi(uint32_t opcode) { // SWI #i
     // Software interrupt
     LOG_SVC(0xFFFFFF)
-    *registers[15] -= 4;
+    registers[15] -= 4;
     return exception(0x08);
 }
 
@@ -153,7 +153,7 @@ int ArmInterp::bkpt(uint32_t opcode) { // BKPT
         LOG_INFO("Triggering ARM9 software breakpoint\n");
     else
         LOG_INFO("Triggering ARM11 core %d software breakpoint\n", id);
-    *registers[15] -= 4;
+    registers[15] -= 4;
     return exception(0x0C);
 }
 
@@ -164,6 +164,7 @@ int ArmInterp::pld(uint32_t opcode) { // PLD address
 
 int ArmInterp::cps(uint32_t opcode) { // CPS[IE/ID] AIF,#mode
     // Optionally enable or disable interrupt flags
+    updateFlags();
     if (opcode & BIT(19)) {
         if (opcode & BIT(18)) // ID
             cpsr |= (opcode & 0xE0);
@@ -179,38 +180,30 @@ int ArmInterp::cps(uint32_t opcode) { // CPS[IE/ID] AIF,#mode
 
 int ArmInterp::srs(uint32_t opcode) { // SRS[DA/IA/DB/IB] sp!,#mode
     // Get the stack pointer for the specified CPU mode
-    uint32_t *op0;
-    switch (opcode & 0x1F) {
-        case 0x11: op0 = &registersFiq[5]; break; // FIQ
-        case 0x12: op0 = &registersIrq[0]; break; // IRQ
-        case 0x13: op0 = &registersSvc[0]; break; // Supervisor
-        case 0x17: op0 = &registersAbt[0]; break; // Abort
-        case 0x1B: op0 = &registersUnd[0]; break; // Undefined
-        default: op0 = &registersUsr[13]; break; // User/System
-    }
+    uint32_t *op0 = modeRegister(opcode & 0x1F, 13);
 
     // Store return state based on the addressing mode
     switch ((opcode >> 23) & 0x3) {
     case 0x0: // DA
-        core.cp15.write<uint32_t>(id, *op0 - 4, *registers[14]);
+        core.cp15.write<uint32_t>(id, *op0 - 4, registers[14]);
         core.cp15.write<uint32_t>(id, *op0 - 0, spsr ? *spsr : 0);
         if (opcode & BIT(21)) *op0 -= 8; // Writeback
         return 1;
 
     case 0x1: // IA
-        core.cp15.write<uint32_t>(id, *op0 + 0, *registers[14]);
+        core.cp15.write<uint32_t>(id, *op0 + 0, registers[14]);
         core.cp15.write<uint32_t>(id, *op0 + 4, spsr ? *spsr : 0);
         if (opcode & BIT(21)) *op0 += 8; // Writeback
         return 1;
 
     case 0x2: // DB
-        core.cp15.write<uint32_t>(id, *op0 - 8, *registers[14]);
+        core.cp15.write<uint32_t>(id, *op0 - 8, registers[14]);
         core.cp15.write<uint32_t>(id, *op0 - 4, spsr ? *spsr : 0);
         if (opcode & BIT(21)) *op0 -= 8; // Writeback
         return 1;
 
     case 0x3: // IB
-        core.cp15.write<uint32_t>(id, *op0 + 4, *registers[14]);
+        core.cp15.write<uint32_t>(id, *op0 + 4, registers[14]);
         core.cp15.write<uint32_t>(id, *op0 + 8, spsr ? *spsr : 0);
         if (opcode & BIT(21)) *op0 += 8; // Writeback
         return 1;
@@ -219,28 +212,28 @@ int ArmInterp::srs(uint32_t opcode) { // SRS[DA/IA/DB/IB] sp!,#mode
 
 int ArmInterp::rfe(uint32_t opcode) { // RFE[DA/IA/DB/IB] Rn!
     // Return from exception based on the addressing mode
-    uint32_t *op0 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 16) & 0xF];
     switch ((opcode >> 23) & 0x3) {
     case 0x0: // DA
-        *registers[15] = core.cp15.read<uint32_t>(id, *op0 - 4);
+        registers[15] = core.cp15.read<uint32_t>(id, *op0 - 4);
         setCpsr(core.cp15.read<uint32_t>(id, *op0 - 0));
         if (opcode & BIT(21)) *op0 -= 8; // Writeback
         break;
 
     case 0x1: // IA
-        *registers[15] = core.cp15.read<uint32_t>(id, *op0 + 0);
+        registers[15] = core.cp15.read<uint32_t>(id, *op0 + 0);
         setCpsr(core.cp15.read<uint32_t>(id, *op0 + 4));
         if (opcode & BIT(21)) *op0 += 8; // Writeback
         break;
 
     case 0x2: // DB
-        *registers[15] = core.cp15.read<uint32_t>(id, *op0 - 8);
+        registers[15] = core.cp15.read<uint32_t>(id, *op0 - 8);
         setCpsr(core.cp15.read<uint32_t>(id, *op0 - 4));
         if (opcode & BIT(21)) *op0 -= 8; // Writeback
         break;
 
     case 0x3: // IB
-        *registers[15] = core.cp15.read<uint32_t>(id, *op0 + 4);
+        registers[15] = core.cp15.read<uint32_t>(id, *op0 + 4);
         setCpsr(core.cp15.read<uint32_t>(id, *op0 + 8));
         if (opcode & BIT(21)) *op0 += 8; // Writeback
         break;
@@ -259,6 +252,7 @@ int ArmInterp::wfi(uint32_t opcode) {
 
 int ArmInterp::wfe(uint32_t opcode) {
     // Halt the CPU until the event flag is set or an interrupt occurs
+    CoreLock lock(core);
     if (!event)
         core.interrupts.halt(id, 1);
     event = false;
@@ -266,203 +260,212 @@ int ArmInterp::wfe(uint32_t opcode) {
 }
 
 int ArmInterp::sev(uint32_t opcode) {
-    // Set the event flag for other CPUs or unhalt them if already waiting
-    uint8_t cores = ~BIT(id) & 0xF;
-    for (int i = 0; cores >> i; i++) {
-        if (~cores & BIT(i)) continue;
-        if (core.arms[i].halted & BIT(1))
-            core.arms[i].unhalt(BIT(1));
-        else
-            core.arms[i].event = true;
-    }
+    // Send an event to the other ARM11 cores
+    CoreLock lock(core);
+    for (int i = 0; i < MAX_CPUS - 1; i++)
+        if (i != id) core.arms[i].sendEvent();
     return 1;
 }
 
 int ArmInterp::bxRegT(uint16_t opcode) { // BX Rs
     // Branch to address and switch to ARM mode if bit 0 is cleared (THUMB)
-    uint32_t op0 = *registers[(opcode >> 3) & 0xF];
+    uint32_t op0 = registers[(opcode >> 3) & 0xF];
     cpsr &= ~((~op0 & BIT(0)) << 5);
-    *registers[15] = op0;
+    registers[15] = op0;
     flushPipeline();
     return 3;
 }
 
 int ArmInterp::blxRegT(uint16_t opcode) { // BLX Rs
     // Branch to address with link and switch to ARM mode if bit 0 is cleared (THUMB)
-    uint32_t op0 = *registers[(opcode >> 3) & 0xF];
+    uint32_t op0 = registers[(opcode >> 3) & 0xF];
     cpsr &= ~((~op0 & BIT(0)) << 5);
-    *registers[14] = *registers[15] - 1;
-    *registers[15] = op0;
+    registers[14] = registers[15] - 1;
+    registers[15] = op0;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::beqT(uint16_t opcode) { // BEQ label
     // Branch to offset if equal (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~cpsr & BIT(30)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bneT(uint16_t opcode) { // BNE label
     // Branch to offset if not equal (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (cpsr & BIT(30)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bcsT(uint16_t opcode) { // BCS label
     // Branch to offset if carry set (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~cpsr & BIT(29)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bccT(uint16_t opcode) { // BCC label
     // Branch to offset if carry clear (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (cpsr & BIT(29)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bmiT(uint16_t opcode) { // BMI label
     // Branch to offset if negative (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~cpsr & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bplT(uint16_t opcode) { // BPL label
     // Branch to offset if positive (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (cpsr & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bvsT(uint16_t opcode) { // BVS label
     // Branch to offset if overflow set (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~cpsr & BIT(28)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bvcT(uint16_t opcode) { // BVC label
     // Branch to offset if overflow clear (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (cpsr & BIT(28)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bhiT(uint16_t opcode) { // BHI label
     // Branch to offset if higher (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if ((cpsr & 0x60000000) != 0x20000000) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::blsT(uint16_t opcode) { // BLS label
     // Branch to offset if lower or same (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if ((cpsr & 0x60000000) == 0x20000000) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bgeT(uint16_t opcode) { // BGE label
     // Branch to offset if signed greater or equal (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if ((cpsr ^ (cpsr << 3)) & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bltT(uint16_t opcode) { // BLT label
     // Branch to offset if signed less than (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~(cpsr ^ (cpsr << 3)) & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bgtT(uint16_t opcode) { // BGT label
     // Branch to offset if signed greater than (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (((cpsr ^ (cpsr << 3)) | (cpsr << 1)) & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bleT(uint16_t opcode) { // BLE label
     // Branch to offset if signed less or equal (THUMB)
     int32_t op0 = (int8_t)opcode << 1;
+    updateFlags();
     if (~((cpsr ^ (cpsr << 3)) | (cpsr << 1)) & BIT(31)) return 1;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::bT(uint16_t opcode) { // B label
     // Branch to offset (THUMB)
     int32_t op0 = (int16_t)(opcode << 5) >> 4;
-    *registers[15] += op0;
+    registers[15] += op0;
     flushPipeline();
-    return 3;
+    return (op0 < 0) ? checkSpin(op0, 3) : 3;
 }
 
 int ArmInterp::blSetupT(uint16_t opcode) { // BL/BLX label
     // Set the upper 11 bits of the target address for a long BL/BLX (THUMB)
     int32_t op0 = (int16_t)(opcode << 5) >> 4;
-    *registers[14] = *registers[15] + (op0 << 11);
+    registers[14] = registers[15] + (op0 << 11);
     return 1;
 }
 
 int ArmInterp::blOffT(uint16_t opcode) { // BL label
     // Long branch to offset with link (THUMB)
     uint32_t op0 = (opcode & 0x7FF) << 1;
-    uint32_t ret = *registers[15] - 1;
-    *registers[15] = *registers[14] + op0;
-    *registers[14] = ret;
+    uint32_t ret = registers[15] - 1;
+    registers[15] = registers[14] + op0;
+    registers[14] = ret;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::blxOffT(uint16_t opcode) { // BLX label
     // Long branch to offset with link and switch to ARM mode (THUMB)
     uint32_t op0 = (opcode & 0x7FF) << 1;
     cpsr &= ~BIT(5);
-    uint32_t ret = *registers[15] - 1;
-    *registers[15] = *registers[14] + op0;
-    *registers[14] = ret;
+    uint32_t ret = registers[15] - 1;
+    registers[15] = registers[14] + op0;
+    registers[14] = ret;
     flushPipeline();
-    return 3;
+    return hle ? hle->checkCall(3) : 3;
 }
 
 int ArmInterp::swiT(uint16_t opcode) { // SWI #i
     // Software interrupt (THUMB)
     LOG_SVC(0xFF)
-    *registers[15] -= 4;
+    registers[15] -= 4;
     return exception(0x08);
 }
 
@@ -472,6 +475,6 @@ int ArmInterp::bkptT(uint16_t opcode) { // BKPT
         LOG_INFO("Triggering ARM9 software breakpoint\n");
     else
         LOG_INFO("Triggering ARM11 core %d software breakpoint\n", id);
-    *registers[15] -= 4;
+    registers[15] -= 4;
     return exception(0x0C);
 }
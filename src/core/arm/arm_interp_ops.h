@@ -0,0 +1,94 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// ARM handlers that get their own dispatch labels when built with computed goto
+// Handlers missing from these lists still work, but dispatch through the lookup tables
+#define ARM_OPS(X) \
+    X(_andLli) X(_andLlr) X(_andLri) X(_andLrr) X(_andAri) X(_andArr) X(_andRri) X(_andRrr) X(mul) X(strhPtrm) \
+    X(ldrdPtrm) X(strdPtrm) X(andsLli) X(andsLlr) X(andsLri) X(andsLrr) X(andsAri) X(andsArr) X(andsRri) X(andsRrr) \
+    X(muls) X(ldrhPtrm) X(ldrsbPtrm) X(ldrshPtrm) X(eorLli) X(eorLlr) X(eorLri) X(eorLrr) X(eorAri) X(eorArr) \
+    X(eorRri) X(eorRrr) X(mla) X(eorsLli) X(eorsLlr) X(eorsLri) X(eorsLrr) X(eorsAri) X(eorsArr) X(eorsRri) \
+    X(eorsRrr) X(mlas) X(subLli) X(subLlr) X(subLri) X(subLrr) X(subAri) X(subArr) X(subRri) X(subRrr) X(unkArm) \
+    X(strhPtim) X(ldrdPtim) X(strdPtim) X(subsLli) X(subsLlr) X(subsLri) X(subsLrr) X(subsAri) X(subsArr) X(subsRri) \
+    X(subsRrr) X(ldrhPtim) X(ldrsbPtim) X(ldrshPtim) X(rsbLli) X(rsbLlr) X(rsbLri) X(rsbLrr) X(rsbAri) X(rsbArr) \
+    X(rsbRri) X(rsbRrr) X(rsbsLli) X(rsbsLlr) X(rsbsLri) X(rsbsLrr) X(rsbsAri) X(rsbsArr) X(rsbsRri) X(rsbsRrr) \
+    X(addLli) X(addLlr) X(addLri) X(addLrr) X(addAri) X(addArr) X(addRri) X(addRrr) X(umull) X(strhPtrp) X(ldrdPtrp) \
+    X(strdPtrp) X(addsLli) X(addsLlr) X(addsLri) X(addsLrr) X(addsAri) X(addsArr) X(addsRri) X(addsRrr) X(umulls) \
+    X(ldrhPtrp) X(ldrsbPtrp) X(ldrshPtrp) X(adcLli) X(adcLlr) X(adcLri) X(adcLrr) X(adcAri) X(adcArr) X(adcRri) \
+    X(adcRrr) X(umlal) X(adcsLli) X(adcsLlr) X(adcsLri) X(adcsLrr) X(adcsAri) X(adcsArr) X(adcsRri) X(adcsRrr) \
+    X(umlals) X(sbcLli) X(sbcLlr) X(sbcLri) X(sbcLrr) X(sbcAri) X(sbcArr) X(sbcRri) X(sbcRrr) X(smull) X(strhPtip) \
+    X(ldrdPtip) X(strdPtip) X(sbcsLli) X(sbcsLlr) X(sbcsLri) X(sbcsLrr) X(sbcsAri) X(sbcsArr) X(sbcsRri) X(sbcsRrr) \
+    X(smulls) X(ldrhPtip) X(ldrsbPtip) X(ldrshPtip) X(rscLli) X(rscLlr) X(rscLri) X(rscLrr) X(rscAri) X(rscArr) \
+    X(rscRri) X(rscRrr) X(smlal) X(rscsLli) X(rscsLlr) X(rscsLri) X(rscsLrr) X(rscsAri) X(rscsArr) X(rscsRri) \
+    X(rscsRrr) X(smlals) X(mrsRc) X(qadd) X(smlabb) X(swp) X(smlatb) X(strhOfrm) X(smlabt) X(ldrdOfrm) X(smlatt) \
+    X(strdOfrm) X(tstLli) X(tstLlr) X(tstLri) X(tstLrr) X(tstAri) X(tstArr) X(tstRri) X(tstRrr) X(ldrhOfrm) \
+    X(ldrsbOfrm) X(ldrshOfrm) X(msrRc) X(bx) X(blxReg) X(qsub) X(bkpt) X(smlawb) X(smulwb) X(strhPrrm) X(smlawt) \
+    X(ldrdPrrm) X(smulwt) X(strdPrrm) X(teqLli) X(teqLlr) X(teqLri) X(teqLrr) X(teqAri) X(teqArr) X(teqRri) X(teqRrr) \
+    X(ldrhPrrm) X(ldrsbPrrm) X(ldrshPrrm) X(mrsRs) X(qdadd) X(smlalbb) X(swpb) X(smlaltb) X(strhOfim) X(smlalbt) \
+    X(ldrdOfim) X(smlaltt) X(strdOfim) X(cmpLli) X(cmpLlr) X(cmpLri) X(cmpLrr) X(cmpAri) X(cmpArr) X(cmpRri) \
+    X(cmpRrr) X(ldrhOfim) X(ldrsbOfim) X(ldrshOfim) X(msrRs) X(clz) X(qdsub) X(smulbb) X(smultb) X(strhPrim) \
+    X(smulbt) X(ldrdPrim) X(smultt) X(strdPrim) X(cmnLli) X(cmnLlr) X(cmnLri) X(cmnLrr) X(cmnAri) X(cmnArr) X(cmnRri) \
+    X(cmnRrr) X(ldrhPrim) X(ldrsbPrim) X(ldrshPrim) X(orrLli) X(orrLlr) X(orrLri) X(orrLrr) X(orrAri) X(orrArr) \
+    X(orrRri) X(orrRrr) X(strex) X(strhOfrp) X(ldrdOfrp) X(strdOfrp) X(orrsLli) X(orrsLlr) X(orrsLri) X(orrsLrr) \
+    X(orrsAri) X(orrsArr) X(orrsRri) X(orrsRrr) X(ldrex) X(ldrhOfrp) X(ldrsbOfrp) X(ldrshOfrp) X(movLli) X(movLlr) \
+    X(movLri) X(movLrr) X(movAri) X(movArr) X(movRri) X(movRrr) X(strexd) X(strhPrrp) X(ldrdPrrp) X(strdPrrp) \
+    X(movsLli) X(movsLlr) X(movsLri) X(movsLrr) X(movsAri) X(movsArr) X(movsRri) X(movsRrr) X(ldrexd) X(ldrhPrrp) \
+    X(ldrsbPrrp) X(ldrshPrrp) X(bicLli) X(bicLlr) X(bicLri) X(bicLrr) X(bicAri) X(bicArr) X(bicRri) X(bicRrr) \
+    X(strexb) X(strhOfip) X(ldrdOfip) X(strdOfip) X(bicsLli) X(bicsLlr) X(bicsLri) X(bicsLrr) X(bicsAri) X(bicsArr) \
+    X(bicsRri) X(bicsRrr) X(ldrexb) X(ldrhOfip) X(ldrsbOfip) X(ldrshOfip) X(mvnLli) X(mvnLlr) X(mvnLri) X(mvnLrr) \
+    X(mvnAri) X(mvnArr) X(mvnRri) X(mvnRrr) X(strexh) X(strhPrip) X(ldrdPrip) X(strdPrip) X(mvnsLli) X(mvnsLlr) \
+    X(mvnsLri) X(mvnsLrr) X(mvnsAri) X(mvnsArr) X(mvnsRri) X(mvnsRrr) X(ldrexh) X(ldrhPrip) X(ldrsbPrip) X(ldrshPrip) \
+    X(_andImm) X(andsImm) X(eorImm) X(eorsImm) X(subImm) X(subsImm) X(rsbImm) X(rsbsImm) X(addImm) X(addsImm) \
+    X(adcImm) X(adcsImm) X(sbcImm) X(sbcsImm) X(rscImm) X(rscsImm) X(tstImm) X(msrIc) X(teqImm) X(cmpImm) X(msrIs) \
+    X(cmnImm) X(orrImm) X(orrsImm) X(movImm) X(movsImm) X(bicImm) X(bicsImm) X(mvnImm) X(mvnsImm) X(strPtim) \
+    X(ldrPtim) X(strbPtim) X(ldrbPtim) X(strPtip) X(ldrPtip) X(strbPtip) X(ldrbPtip) X(strOfim) X(ldrOfim) X(strPrim) \
+    X(ldrPrim) X(strbOfim) X(ldrbOfim) X(strbPrim) X(ldrbPrim) X(strOfip) X(ldrOfip) X(strPrip) X(ldrPrip) \
+    X(strbOfip) X(ldrbOfip) X(strbPrip) X(ldrbPrip) X(strPtrmll) X(strPtrmlr) X(strPtrmar) X(strPtrmrr) X(ldrPtrmll) \
+    X(sadd16) X(ldrPtrmlr) X(ldrPtrmar) X(ldrPtrmrr) X(ssub16) X(sadd8) X(ssub8) X(qsub16) X(qsub8) X(strbPtrmll) \
+    X(strbPtrmlr) X(strbPtrmar) X(strbPtrmrr) X(ldrbPtrmll) X(uadd16) X(ldrbPtrmlr) X(ldrbPtrmar) X(ldrbPtrmrr) \
+    X(usub16) X(uadd8) X(usub8) X(uqadd16) X(uqsub16) X(uqadd8) X(uqsub8) X(uhadd16) X(uhadd8) X(strPtrpll) X(pkhbt) \
+    X(strPtrplr) X(strPtrpar) X(pkhtb) X(strPtrprr) X(sxtab16) X(sel) X(ldrPtrpll) X(ldrPtrplr) X(ldrPtrpar) \
+    X(ldrPtrprr) X(ssatLli) X(ssat16) X(ssatAri) X(sxtab) X(rev) X(sxtah) X(rev16) X(strbPtrpll) X(strbPtrplr) \
+    X(strbPtrpar) X(strbPtrprr) X(uxtab16) X(ldrbPtrpll) X(ldrbPtrplr) X(ldrbPtrpar) X(ldrbPtrprr) X(usatLli) \
+    X(usat16) X(usatAri) X(uxtab) X(uxtah) X(revsh) X(strOfrmll) X(strOfrmlr) X(strOfrmar) X(strOfrmrr) X(ldrOfrmll) \
+    X(ldrOfrmlr) X(ldrOfrmar) X(ldrOfrmrr) X(strPrrmll) X(strPrrmlr) X(strPrrmar) X(strPrrmrr) X(ldrPrrmll) \
+    X(ldrPrrmlr) X(ldrPrrmar) X(ldrPrrmrr) X(strbOfrmll) X(strbOfrmlr) X(strbOfrmar) X(strbOfrmrr) X(ldrbOfrmll) \
+    X(ldrbOfrmlr) X(ldrbOfrmar) X(ldrbOfrmrr) X(strbPrrmll) X(strbPrrmlr) X(strbPrrmar) X(strbPrrmrr) X(ldrbPrrmll) \
+    X(ldrbPrrmlr) X(ldrbPrrmar) X(ldrbPrrmrr) X(strOfrpll) X(strOfrplr) X(strOfrpar) X(strOfrprr) X(ldrOfrpll) \
+    X(ldrOfrplr) X(ldrOfrpar) X(ldrOfrprr) X(strPrrpll) X(strPrrplr) X(strPrrpar) X(strPrrprr) X(ldrPrrpll) \
+    X(ldrPrrplr) X(ldrPrrpar) X(ldrPrrprr) X(strbOfrpll) X(strbOfrplr) X(strbOfrpar) X(strbOfrprr) X(ldrbOfrpll) \
+    X(ldrbOfrplr) X(ldrbOfrpar) X(ldrbOfrprr) X(strbPrrpll) X(strbPrrplr) X(strbPrrpar) X(strbPrrprr) X(ldrbPrrpll) \
+    X(ldrbPrrplr) X(ldrbPrrpar) X(ldrbPrrprr) X(stmda) X(ldmda) X(stmdaW) X(ldmdaW) X(stmdaU) X(ldmdaU) X(stmdaUW) \
+    X(ldmdaUW) X(stmia) X(ldmia) X(stmiaW) X(ldmiaW) X(stmiaU) X(ldmiaU) X(stmiaUW) X(ldmiaUW) X(stmdb) X(ldmdb) \
+    X(stmdbW) X(ldmdbW) X(stmdbU) X(ldmdbU) X(stmdbUW) X(ldmdbUW) X(stmib) X(ldmib) X(stmibW) X(ldmibW) X(stmibU) \
+    X(ldmibU) X(stmibUW) X(ldmibUW) X(b) X(bl) X(stc) X(ldc) X(mcrr) X(mrrc) X(cdp) X(mcr) X(mrc) X(swi)
+
+// THUMB handlers that get their own dispatch labels when built with computed goto
+#define THUMB_OPS(X) \
+    X(lslImmT) X(lsrImmT) X(asrImmT) X(addRegT) X(subRegT) X(addImm3T) X(subImm3T) X(movImm8T) X(cmpImm8T) \
+    X(addImm8T) X(subImm8T) X(andDpT) X(eorDpT) X(lslDpT) X(lsrDpT) X(asrDpT) X(adcDpT) X(sbcDpT) X(rorDpT) X(tstDpT) \
+    X(negDpT) X(cmpDpT) X(cmnDpT) X(orrDpT) X(mulDpT) X(bicDpT) X(mvnDpT) X(addHT) X(cmpHT) X(movHT) X(bxRegT) \
+    X(blxRegT) X(ldrPcT) X(strRegT) X(strhRegT) X(strbRegT) X(ldrsbRegT) X(ldrRegT) X(ldrhRegT) X(ldrbRegT) \
+    X(ldrshRegT) X(strImm5T) X(ldrImm5T) X(strbImm5T) X(ldrbImm5T) X(strhImm5T) X(ldrhImm5T) X(strSpT) X(ldrSpT) \
+    X(addPcT) X(addSpT) X(addSpImmT) X(unkThumb) X(sxthT) X(sxtbT) X(uxthT) X(uxtbT) X(pushT) X(pushLrT) X(revT) \
+    X(rev16T) X(revshT) X(popT) X(popPcT) X(bkptT) X(stmiaT) X(ldmiaT) X(beqT) X(bneT) X(bcsT) X(bccT) X(bmiT) \
+    X(bplT) X(bvsT) X(bvcT) X(bhiT) X(blsT) X(bgeT) X(bltT) X(bgtT) X(bleT) X(swiT) X(bT) X(blxOffT) X(blSetupT) \
+    X(blOffT)
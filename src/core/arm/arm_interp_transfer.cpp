@@ -93,12 +93,12 @@ FORCE_INLINE uint32_t ArmInterp::ipH(uint32_t opcode) { // #i (SB/SH/H/D)
 
 FORCE_INLINE uint32_t ArmInterp::rp(uint32_t opcode) { // Rm
     // Register offset for signed and half-word transfers
-    return *registers[opcode & 0xF];
+    return registers[opcode & 0xF];
 }
 
 FORCE_INLINE uint32_t ArmInterp::rpll(uint32_t opcode) { // Rm,LSL #i
     // Logical shift left by immediate
-    uint32_t value = *registers[opcode & 0xF];
+    uint32_t value = registers[opcode & 0xF];
     uint8_t shift = (opcode >> 7) & 0x1F;
     return value << shift;
 }
@@ -106,7 +106,7 @@ FORCE_INLINE uint32_t ArmInterp::rpll(uint32_t opcode) { // Rm,LSL #i
 FORCE_INLINE uint32_t ArmInterp::rplr(uint32_t opcode) { // Rm,LSR #i
     // Logical shift right by immediate
     // A shift of 0 translates to a shift of 32
-    uint32_t value = *registers[opcode & 0xF];
+    uint32_t value = registers[opcode & 0xF];
     uint8_t shift = (opcode >> 7) & 0x1F;
     return shift ? (value >> shift) : 0;
 }
@@ -114,7 +114,7 @@ FORCE_INLINE uint32_t ArmInterp::rplr(uint32_t opcode) { // Rm,LSR #i
 FORCE_INLINE uint32_t ArmInterp::rpar(uint32_t opcode) { // Rm,ASR #i
     // Arithmetic shift right by immediate
     // A shift of 0 translates to a shift of 32
-    int32_t value = *registers[opcode & 0xF];
+    int32_t value = registers[opcode & 0xF];
     uint8_t shift = (opcode >> 7) & 0x1F;
     return value >> (shift ? shift : 31);
 }
@@ -122,43 +122,44 @@ FORCE_INLINE uint32_t ArmInterp::rpar(uint32_t opcode) { // Rm,ASR #i
 FORCE_INLINE uint32_t ArmInterp::rprr(uint32_t opcode) { // Rm,ROR #i
     // Rotate right by immediate
     // A shift of 0 translates to a1 rotate with carry of 1
-    uint32_t value = *registers[opcode & 0xF];
+    uint32_t value = registers[opcode & 0xF];
     uint8_t shift = (opcode >> 7) & 0x1F;
+    updateFlags();
     return shift ? ((value << (32 - shift)) | (value >> shift)) : (((cpsr & BIT(29)) << 2) | (value >> 1));
 }
 
 FORCE_INLINE int ArmInterp::ldrsbOf(uint32_t opcode, uint32_t op2) { // LDRSB Rd,[Rn,op2]
     // Signed byte load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     *op0 = (int8_t)core.cp15.read<uint8_t>(id, op1 + op2);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrshOf(uint32_t opcode, uint32_t op2) { // LDRSH Rd,[Rn,op2]
     // Signed half-word load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     *op0 = (int16_t)core.cp15.read<uint16_t>(id, op1 += op2);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrbOf(uint32_t opcode, uint32_t op2) { // LDRB Rd,[Rn,op2]
     // Byte load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint8_t>(id, op1 + op2);
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -167,20 +168,20 @@ FORCE_INLINE int ArmInterp::ldrbOf(uint32_t opcode, uint32_t op2) { // LDRB Rd,[
 FORCE_INLINE int ArmInterp::strbOf(uint32_t opcode, uint32_t op2) { // STRB Rd,[Rn,op2]
     // Byte store, pre-adjust without writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint8_t>(id, op1 + op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrhOf(uint32_t opcode, uint32_t op2) { // LDRH Rd,[Rn,op2]
     // Half-word load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint16_t>(id, op1 += op2);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
@@ -188,16 +189,16 @@ FORCE_INLINE int ArmInterp::ldrhOf(uint32_t opcode, uint32_t op2) { // LDRH Rd,[
 FORCE_INLINE int ArmInterp::strhOf(uint32_t opcode, uint32_t op2) { // STRH Rd,[Rn,op2]
     // Half-word store, pre-adjust without writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint16_t>(id, op1 + op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrOf(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn,op2]
     // Word load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint32_t>(id, op1 += op2);
 
     // Rotate misaligned reads on ARM9
@@ -207,7 +208,7 @@ FORCE_INLINE int ArmInterp::ldrOf(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
     }
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -216,17 +217,17 @@ FORCE_INLINE int ArmInterp::ldrOf(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
 FORCE_INLINE int ArmInterp::strOf(uint32_t opcode, uint32_t op2) { // STR Rd,[Rn,op2]
     // Word store, pre-adjust without writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, op1 + op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrdOf(uint32_t opcode, uint32_t op2) { // LDRD Rd,[Rn,op2]
     // Double word load, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     op0[0] = core.cp15.read<uint32_t>(id, op1 += op2);
     op0[1] = core.cp15.read<uint32_t>(id, op1 + 4);
     return 2;
@@ -234,9 +235,9 @@ FORCE_INLINE int ArmInterp::ldrdOf(uint32_t opcode, uint32_t op2) { // LDRD Rd,[
 
 FORCE_INLINE int ArmInterp::strdOf(uint32_t opcode, uint32_t op2) { // STRD Rd,[Rn,op2]
     // Double word store, pre-adjust without writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, op1 += op2, op0[0]);
     core.cp15.write<uint32_t>(id, op1 + 4, op0[1]);
     return 2;
@@ -244,37 +245,37 @@ FORCE_INLINE int ArmInterp::strdOf(uint32_t opcode, uint32_t op2) { // STRD Rd,[
 
 FORCE_INLINE int ArmInterp::ldrsbPr(uint32_t opcode, uint32_t op2) { // LDRSB Rd,[Rn,op2]!
     // Signed byte load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     *op0 = (int8_t)core.cp15.read<uint8_t>(id, *op1 += op2);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrshPr(uint32_t opcode, uint32_t op2) { // LDRSH Rd,[Rn,op2]!
     // Signed half-word load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = *op1 += op2;
     *op0 = (int16_t)core.cp15.read<uint16_t>(id, address);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrbPr(uint32_t opcode, uint32_t op2) { // LDRB Rd,[Rn,op2]!
     // Byte load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint8_t>(id, *op1 += op2);
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -283,21 +284,21 @@ FORCE_INLINE int ArmInterp::ldrbPr(uint32_t opcode, uint32_t op2) { // LDRB Rd,[
 FORCE_INLINE int ArmInterp::strbPr(uint32_t opcode, uint32_t op2) { // STRB Rd,[Rn,op2]!
     // Byte store, pre-adjust with writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint8_t>(id, *op1 += op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrhPr(uint32_t opcode, uint32_t op2) { // LDRH Rd,[Rn,op2]!
     // Half-word load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = *op1 += op2;
     *op0 = core.cp15.read<uint16_t>(id, address);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
@@ -305,16 +306,16 @@ FORCE_INLINE int ArmInterp::ldrhPr(uint32_t opcode, uint32_t op2) { // LDRH Rd,[
 FORCE_INLINE int ArmInterp::strhPr(uint32_t opcode, uint32_t op2) { // STRH Rd,[Rn,op2]!
     // Half-word store, pre-adjust with writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint16_t>(id, *op1 += op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrPr(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn,op2]!
     // Word load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = *op1 += op2;
     *op0 = core.cp15.read<uint32_t>(id, address);
 
@@ -325,7 +326,7 @@ FORCE_INLINE int ArmInterp::ldrPr(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
     }
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -334,17 +335,17 @@ FORCE_INLINE int ArmInterp::ldrPr(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
 FORCE_INLINE int ArmInterp::strPr(uint32_t opcode, uint32_t op2) { // STR Rd,[Rn,op2]!
     // Word store, pre-adjust with writeback
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, *op1 += op2, op0);
     return 1;
 }
 
 FORCE_INLINE int ArmInterp::ldrdPr(uint32_t opcode, uint32_t op2) { // LDRD Rd,[Rn,op2]!
     // Double word load, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     op0[0] = core.cp15.read<uint32_t>(id, *op1 += op2);
     op0[1] = core.cp15.read<uint32_t>(id, *op1 + 4);
     return 2;
@@ -352,9 +353,9 @@ FORCE_INLINE int ArmInterp::ldrdPr(uint32_t opcode, uint32_t op2) { // LDRD Rd,[
 
 FORCE_INLINE int ArmInterp::strdPr(uint32_t opcode, uint32_t op2) { // STRD Rd,[Rn,op2]!
     // Double word store, pre-adjust with writeback
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, *op1 += op2, op0[0]);
     core.cp15.write<uint32_t>(id, *op1 + 4, op0[1]);
     return 2;
@@ -362,39 +363,39 @@ FORCE_INLINE int ArmInterp::strdPr(uint32_t opcode, uint32_t op2) { // STRD Rd,[
 
 FORCE_INLINE int ArmInterp::ldrsbPt(uint32_t opcode, uint32_t op2) { // LDRSB Rd,[Rn],op2
     // Signed byte load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     *op0 = (int8_t)core.cp15.read<uint8_t>(id, address);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrshPt(uint32_t opcode, uint32_t op2) { // LDRSH Rd,[Rn],op2
     // Signed half-word load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     *op0 = (int16_t)core.cp15.read<uint16_t>(id, address);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
 
 FORCE_INLINE int ArmInterp::ldrbPt(uint32_t opcode, uint32_t op2) { // LDRB Rd,[Rn],op2
     // Byte load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     *op0 = core.cp15.read<uint8_t>(id, address);
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -403,8 +404,8 @@ FORCE_INLINE int ArmInterp::ldrbPt(uint32_t opcode, uint32_t op2) { // LDRB Rd,[
 FORCE_INLINE int ArmInterp::strbPt(uint32_t opcode, uint32_t op2) { // STRB Rd,[Rn],op2
     // Byte store, post-adjust
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint8_t>(id, *op1, op0);
     *op1 += op2;
     return 1;
@@ -412,13 +413,13 @@ FORCE_INLINE int ArmInterp::strbPt(uint32_t opcode, uint32_t op2) { // STRB Rd,[
 
 FORCE_INLINE int ArmInterp::ldrhPt(uint32_t opcode, uint32_t op2) { // LDRH Rd,[Rn],op2
     // Half-word load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     *op0 = core.cp15.read<uint16_t>(id, address);
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
@@ -426,8 +427,8 @@ FORCE_INLINE int ArmInterp::ldrhPt(uint32_t opcode, uint32_t op2) { // LDRH Rd,[
 FORCE_INLINE int ArmInterp::strhPt(uint32_t opcode, uint32_t op2) { // STRH Rd,[Rn],op2
     // Half-word store, post-adjust
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint16_t>(id, *op1, op0);
     *op1 += op2;
     return 1;
@@ -435,8 +436,8 @@ FORCE_INLINE int ArmInterp::strhPt(uint32_t opcode, uint32_t op2) { // STRH Rd,[
 
 FORCE_INLINE int ArmInterp::ldrPt(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn],op2
     // Word load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     *op0 = core.cp15.read<uint32_t>(id, address);
 
@@ -447,7 +448,7 @@ FORCE_INLINE int ArmInterp::ldrPt(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
     }
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -456,8 +457,8 @@ FORCE_INLINE int ArmInterp::ldrPt(uint32_t opcode, uint32_t op2) { // LDR Rd,[Rn
 FORCE_INLINE int ArmInterp::strPt(uint32_t opcode, uint32_t op2) { // STR Rd,[Rn],op2
     // Word store, post-adjust
     // When used as Rd, the program counter is read with +4
-    uint32_t op0 = *registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 12) & 0xF] + (((opcode & 0xF000) == 0xF000) << 2);
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, *op1, op0);
     *op1 += op2;
     return 1;
@@ -465,9 +466,9 @@ FORCE_INLINE int ArmInterp::strPt(uint32_t opcode, uint32_t op2) { // STR Rd,[Rn
 
 FORCE_INLINE int ArmInterp::ldrdPt(uint32_t opcode, uint32_t op2) { // LDRD Rd,[Rn],op2
     // Double word load, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     uint32_t address = (*op1 += op2) - op2;
     op0[0] = core.cp15.read<uint32_t>(id, address);
     op0[1] = core.cp15.read<uint32_t>(id, address + 4);
@@ -476,27 +477,68 @@ FORCE_INLINE int ArmInterp::ldrdPt(uint32_t opcode, uint32_t op2) { // LDRD Rd,[
 
 FORCE_INLINE int ArmInterp::strdPt(uint32_t opcode, uint32_t op2) { // STRD Rd,[Rn],op2
     // Double word store, post-adjust
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t *op1 = registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t *op1 = &registers[(opcode >> 16) & 0xF];
     core.cp15.write<uint32_t>(id, *op1, op0[0]);
     core.cp15.write<uint32_t>(id, *op1 + 4, op0[1]);
     *op1 += op2;
     return 2;
 }
 
+FORCE_INLINE void ArmInterp::loadBlock(uint32_t address, uint16_t list, uint8_t m) {
+    // Load registers straight from host memory if the block is aligned and within one page
+    if (!(address & 0x3) && (address & 0xFFF) + (m << 2) <= 0x1000) {
+        if (uint8_t *data = core.cp15.getReadPtr(id, address)) {
+            data += (address & 0xFFF);
+            for (int i = 0; i < 16; i++) {
+                if (~list & BIT(i)) continue;
+                registers[i] = U8TO32(data, 0);
+                data += 4;
+            }
+            return;
+        }
+    }
+
+    // Fall back to loading each register separately
+    for (int i = 0; i < 16; i++) {
+        if (~list & BIT(i)) continue;
+        registers[i] = core.cp15.read<uint32_t>(id, address);
+        address += 4;
+    }
+}
+
+FORCE_INLINE void ArmInterp::storeBlock(uint32_t address, uint16_t list, uint8_t m) {
+    // Store registers straight to host memory if the block is aligned and within one page
+    if (!(address & 0x3) && (address & 0xFFF) + (m << 2) <= 0x1000) {
+        if (uint8_t *data = core.cp15.getWritePtr(id, address)) {
+            data += (address & 0xFFF);
+            for (int i = 0; i < 16; i++) {
+                if (~list & BIT(i)) continue;
+                U8TO32(data, 0) = registers[i];
+                data += 4;
+            }
+            return;
+        }
+    }
+
+    // Fall back to storing each register separately
+    for (int i = 0; i < 16; i++) {
+        if (~list & BIT(i)) continue;
+        core.cp15.write<uint32_t>(id, address, registers[i]);
+        address += 4;
+    }
+}
+
 int ArmInterp::ldmda(uint32_t opcode) { // LDMDA Rn, <Rlist>
     // Block load, post-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, op0 += 4);
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    loadBlock(op0 + 4, opcode, m);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -504,27 +546,20 @@ int ArmInterp::ldmda(uint32_t opcode) { // LDMDA Rn, <Rlist>
 int ArmInterp::stmda(uint32_t opcode) { // STMDA Rn, <Rlist>
     // Block store, post-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0 += 4, *registers[i]);
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    storeBlock(op0 + 4, opcode, m);
     return m + (m < 2);
 }
 
 int ArmInterp::ldmia(uint32_t opcode) { // LDMIA Rn, <Rlist>
     // Block load, post-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, op0);
-        op0 += 4;
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    loadBlock(op0, opcode, m);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -532,28 +567,20 @@ int ArmInterp::ldmia(uint32_t opcode) { // LDMIA Rn, <Rlist>
 int ArmInterp::stmia(uint32_t opcode) { // STMIA Rn, <Rlist>
     // Block store, post-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0, *registers[i]);
-        op0 += 4;
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    storeBlock(op0, opcode, m);
     return m + (m < 2);
 }
 
 int ArmInterp::ldmdb(uint32_t opcode) { // LDMDB Rn, <Rlist>
     // Block load, pre-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, op0);
-        op0 += 4;
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    loadBlock(op0, opcode, m);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -561,27 +588,20 @@ int ArmInterp::ldmdb(uint32_t opcode) { // LDMDB Rn, <Rlist>
 int ArmInterp::stmdb(uint32_t opcode) { // STMDB Rn, <Rlist>
     // Block store, pre-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0, *registers[i]);
-        op0 += 4;
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    storeBlock(op0, opcode, m);
     return m + (m < 2);
 }
 
 int ArmInterp::ldmib(uint32_t opcode) { // LDMIB Rn, <Rlist>
     // Block load, pre-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, op0 += 4);
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    loadBlock(op0 + 4, opcode, m);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -589,11 +609,8 @@ int ArmInterp::ldmib(uint32_t opcode) { // LDMIB Rn, <Rlist>
 int ArmInterp::stmib(uint32_t opcode) { // STMIB Rn, <Rlist>
     // Block store, pre-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0 += 4, *registers[i]);
-    }
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    storeBlock(op0 + 4, opcode, m);
     return m + (m < 2);
 }
 
@@ -601,19 +618,16 @@ int ArmInterp::ldmdaW(uint32_t opcode) { // LDMDA Rn!, <Rlist>
     // Block load, post-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] -= (m << 2));
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, address += 4);
-    }
+    uint32_t address = (registers[op0] -= (m << 2));
+    loadBlock(address + 4, opcode, m);
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address - (m << 2);
+        registers[op0] = address;
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -622,12 +636,9 @@ int ArmInterp::stmdaW(uint32_t opcode) { // STMDA Rn!, <Rlist>
     // Block store, post-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address += 4, *registers[i]);
-    }
-    *registers[op0] = address - (m << 2);
+    uint32_t address = registers[op0] - (m << 2);
+    storeBlock(address + 4, opcode, m);
+    registers[op0] = address;
     return m + (m < 2);
 }
 
@@ -635,20 +646,16 @@ int ArmInterp::ldmiaW(uint32_t opcode) { // LDMIA Rn!, <Rlist>
     // Block load, post-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] += (m << 2)) - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, address);
-        address += 4;
-    }
+    uint32_t address = (registers[op0] += (m << 2)) - (m << 2);
+    loadBlock(address, opcode, m);
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address;
+        registers[op0] = address + (m << 2);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -657,13 +664,9 @@ int ArmInterp::stmiaW(uint32_t opcode) { // STMIA Rn!, <Rlist>
     // Block store, post-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, *registers[i]);
-        address += 4;
-    }
-    *registers[op0] = address;
+    uint32_t address = registers[op0];
+    storeBlock(address, opcode, m);
+    registers[op0] = address + (m << 2);
     return m + (m < 2);
 }
 
@@ -671,20 +674,16 @@ int ArmInterp::ldmdbW(uint32_t opcode) { // LDMDB Rn!, <Rlist>
     // Block load, pre-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] -= (m << 2));
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, address);
-        address += 4;
-    }
+    uint32_t address = (registers[op0] -= (m << 2));
+    loadBlock(address, opcode, m);
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address - (m << 2);
+        registers[op0] = address;
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -693,13 +692,9 @@ int ArmInterp::stmdbW(uint32_t opcode) { // STMDB Rn!, <Rlist>
     // Block store, pre-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0] - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, *registers[i]);
-        address += 4;
-    }
-    *registers[op0] = address - (m << 2);
+    uint32_t address = registers[op0] - (m << 2);
+    storeBlock(address, opcode, m);
+    registers[op0] = address;
     return m + (m < 2);
 }
 
@@ -707,19 +702,16 @@ int ArmInterp::ldmibW(uint32_t opcode) { // LDMIB Rn!, <Rlist>
     // Block load, pre-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] += (m << 2)) - (m << 2);
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, address += 4);
-    }
+    uint32_t address = (registers[op0] += (m << 2)) - (m << 2);
+    loadBlock(address + 4, opcode, m);
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address;
+        registers[op0] = address + (m << 2);
 
     // Handle pipelining and THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -728,29 +720,26 @@ int ArmInterp::stmibW(uint32_t opcode) { // STMIB Rn!, <Rlist>
     // Block store, pre-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0];
-    for (int i = 0; i < 16; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address += 4, *registers[i]);
-    }
-    *registers[op0] = address;
+    uint32_t address = registers[op0];
+    storeBlock(address + 4, opcode, m);
+    registers[op0] = address + (m << 2);
     return m + (m < 2);
 }
 
 int ArmInterp::ldmdaU(uint32_t opcode) { // LDMDA Rn, <Rlist>^
     // User block load, post-decrement without writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, op0 += 4);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, op0 += 4);
     }
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -758,10 +747,10 @@ int ArmInterp::ldmdaU(uint32_t opcode) { // LDMDA Rn, <Rlist>^
 int ArmInterp::stmdaU(uint32_t opcode) { // STMDA Rn, <Rlist>^
     // User block store, post-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0 += 4, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, op0 += 4, *modeRegister(0x10, i));
     }
     return m + (m < 2);
 }
@@ -769,18 +758,18 @@ int ArmInterp::stmdaU(uint32_t opcode) { // STMDA Rn, <Rlist>^
 int ArmInterp::ldmiaU(uint32_t opcode) { // LDMIA Rn, <Rlist>^
     // User block load, post-increment without writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, op0);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, op0);
         op0 += 4;
     }
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -788,10 +777,10 @@ int ArmInterp::ldmiaU(uint32_t opcode) { // LDMIA Rn, <Rlist>^
 int ArmInterp::stmiaU(uint32_t opcode) { // STMIA Rn, <Rlist>^
     // User block store, post-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, op0, *modeRegister(0x10, i));
         op0 += 4;
     }
     return m + (m < 2);
@@ -800,18 +789,18 @@ int ArmInterp::stmiaU(uint32_t opcode) { // STMIA Rn, <Rlist>^
 int ArmInterp::ldmdbU(uint32_t opcode) { // LDMDB Rn, <Rlist>^
     // User block load, pre-decrement without writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, op0);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, op0);
         op0 += 4;
     }
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -819,10 +808,10 @@ int ArmInterp::ldmdbU(uint32_t opcode) { // LDMDB Rn, <Rlist>^
 int ArmInterp::stmdbU(uint32_t opcode) { // STMDB Rn, <Rlist>^
     // User block store, pre-decrement without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF] - (m << 2);
+    uint32_t op0 = registers[(opcode >> 16) & 0xF] - (m << 2);
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, op0, *modeRegister(0x10, i));
         op0 += 4;
     }
     return m + (m < 2);
@@ -831,17 +820,17 @@ int ArmInterp::stmdbU(uint32_t opcode) { // STMDB Rn, <Rlist>^
 int ArmInterp::ldmibU(uint32_t opcode) { // LDMIB Rn, <Rlist>^
     // User block load, pre-increment without writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, op0 += 4);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, op0 += 4);
     }
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -849,10 +838,10 @@ int ArmInterp::ldmibU(uint32_t opcode) { // LDMIB Rn, <Rlist>^
 int ArmInterp::stmibU(uint32_t opcode) { // STMIB Rn, <Rlist>^
     // User block store, pre-increment without writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
-    uint32_t op0 = *registers[(opcode >> 16) & 0xF];
+    uint32_t op0 = registers[(opcode >> 16) & 0xF];
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, op0 += 4, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, op0 += 4, *modeRegister(0x10, i));
     }
     return m + (m < 2);
 }
@@ -861,21 +850,21 @@ int ArmInterp::ldmdaUW(uint32_t opcode) { // LDMDA Rn!, <Rlist>^
     // User block load, post-decrement with writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] -= (m << 2));
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t address = (registers[op0] -= (m << 2));
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, address += 4);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, address += 4);
     }
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address - (m << 2);
+        registers[op0] = address - (m << 2);
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -884,12 +873,12 @@ int ArmInterp::stmdaUW(uint32_t opcode) { // STMDA Rn!, <Rlist>^
     // User block store, post-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0] - (m << 2);
+    uint32_t address = registers[op0] - (m << 2);
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address += 4, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, address += 4, *modeRegister(0x10, i));
     }
-    *registers[op0] = address - (m << 2);
+    registers[op0] = address - (m << 2);
     return m + (m < 2);
 }
 
@@ -897,22 +886,22 @@ int ArmInterp::ldmiaUW(uint32_t opcode) { // LDMIA Rn!, <Rlist>^
     // User block load, post-increment with writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] += (m << 2)) - (m << 2);
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t address = (registers[op0] += (m << 2)) - (m << 2);
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, address);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, address);
         address += 4;
     }
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address;
+        registers[op0] = address;
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -921,13 +910,13 @@ int ArmInterp::stmiaUW(uint32_t opcode) { // STMIA Rn!, <Rlist>^
     // User block store, post-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0];
+    uint32_t address = registers[op0];
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, address, *modeRegister(0x10, i));
         address += 4;
     }
-    *registers[op0] = address;
+    registers[op0] = address;
     return m + (m < 2);
 }
 
@@ -935,22 +924,22 @@ int ArmInterp::ldmdbUW(uint32_t opcode) { // LDMDB Rn!, <Rlist>^
     // User block load, pre-decrement with writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] -= (m << 2));
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t address = (registers[op0] -= (m << 2));
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, address);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, address);
         address += 4;
     }
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address - (m << 2);
+        registers[op0] = address - (m << 2);
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -959,13 +948,13 @@ int ArmInterp::stmdbUW(uint32_t opcode) { // STMDB Rn!, <Rlist>^
     // User block store, pre-decrement with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0] - (m << 2);
+    uint32_t address = registers[op0] - (m << 2);
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, address, *modeRegister(0x10, i));
         address += 4;
     }
-    *registers[op0] = address - (m << 2);
+    registers[op0] = address - (m << 2);
     return m + (m < 2);
 }
 
@@ -973,21 +962,21 @@ int ArmInterp::ldmibUW(uint32_t opcode) { // LDMIB Rn!, <Rlist>^
     // User block load, pre-increment with writeback; normal registers if branching
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = (*registers[op0] += (m << 2)) - (m << 2);
-    uint32_t **regs = &registers[(~opcode & BIT(15)) >> 11];
+    uint32_t address = (registers[op0] += (m << 2)) - (m << 2);
+    bool user = (~opcode & BIT(15));
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        *regs[i] = core.cp15.read<uint32_t>(id, address += 4);
+        *(user ? modeRegister(0x10, i) : &registers[i]) = core.cp15.read<uint32_t>(id, address += 4);
     }
 
     // Load the writeback value if it's not last or is the only listed register
     if ((opcode & 0xFFFF & ~(BIT(op0 + 1) - 1)) || (opcode & 0xFFFF) == BIT(op0))
-        *registers[op0] = address;
+        registers[op0] = address;
 
     // Handle pipelining and mode/THUMB switching
     if (~opcode & BIT(15)) return m + (m < 2);
     if (spsr) setCpsr(*spsr);
-    cpsr |= (*registers[15] & 0x1) << 5;
+    cpsr |= (registers[15] & 0x1) << 5;
     flushPipeline();
     return m + 4;
 }
@@ -996,18 +985,19 @@ int ArmInterp::stmibUW(uint32_t opcode) { // STMIB Rn!, <Rlist>^
     // User block store, pre-increment with writeback
     uint8_t m = bitCount[opcode & 0xFF] + bitCount[(opcode >> 8) & 0xFF];
     uint8_t op0 = (opcode >> 16) & 0xF;
-    uint32_t address = *registers[op0];
+    uint32_t address = registers[op0];
     for (int i = 0; i < 16; i++) {
         if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address += 4, registersUsr[i]);
+        core.cp15.write<uint32_t>(id, address += 4, *modeRegister(0x10, i));
     }
-    *registers[op0] = address;
+    registers[op0] = address;
     return m + (m < 2);
 }
 
 int ArmInterp::msrRc(uint32_t opcode) { // MSR CPSR,Rm
     // Write the first 8 bits of the status flags, only changing the CPU mode when not in user mode
-    uint32_t op1 = *registers[opcode & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    updateFlags();
     if (opcode & BIT(16)) {
         uint8_t mask = ((cpsr & 0x1F) == 0x10) ? 0xE0 : 0xFF;
         setCpsr((cpsr & ~mask) | (op1 & mask));
@@ -1024,7 +1014,7 @@ int ArmInterp::msrRc(uint32_t opcode) { // MSR CPSR,Rm
 int ArmInterp::msrRs(uint32_t opcode) { // MSR SPSR,Rm
     // Write the saved status flags in 8-bit blocks
     if (!spsr) return 1;
-    uint32_t op1 = *registers[opcode & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
     for (int i = 0; i < 4; i++) {
         if (opcode & BIT(16 + i))
             *spsr = (*spsr & ~(0xFF << (i << 3))) | (op1 & (0xFF << (i << 3)));
@@ -1051,6 +1041,7 @@ int ArmInterp::msrIc(uint32_t opcode) { // MSR CPSR,#i
     uint32_t op1 = (value << (32 - shift)) | (value >> shift);
 
     // Write the first 8 bits of the status flags, only changing the CPU mode when not in user mode
+    updateFlags();
     if (opcode & BIT(16)) {
         uint8_t mask = ((cpsr & 0x1F) == 0x10) ? 0xE0 : 0xFF;
         setCpsr((cpsr & ~mask) | (op1 & mask));
@@ -1081,14 +1072,15 @@ int ArmInterp::msrIs(uint32_t opcode) { // MSR SPSR,#i
 
 int ArmInterp::mrsRc(uint32_t opcode) { // MRS Rd,CPSR
     // Copy the status flags to a register
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    updateFlags();
     *op0 = cpsr;
     return 2;
 }
 
 int ArmInterp::mrsRs(uint32_t opcode) { // MRS Rd,SPSR
     // Copy the saved status flags to a register
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
     if (spsr) *op0 = *spsr;
     return 2;
 }
@@ -1097,7 +1089,7 @@ int ArmInterp::mrc(uint32_t opcode) { // MRC Pn,<cpopc>,Rd,Cn,Cm,<cp>
     // Decode the operands
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 21) & 0x7;
-    uint32_t *rd = registers[(opcode >> 12) & 0xF];
+    uint32_t *rd = &registers[(opcode >> 12) & 0xF];
     uint8_t cn = (opcode >> 16) & 0xF;
     uint8_t cm = (opcode & 0xF);
     uint8_t cp = (opcode >> 5) & 0x7;
@@ -1131,7 +1123,7 @@ int ArmInterp::mcr(uint32_t opcode) { // MCR Pn,<cpopc>,Rd,Cn,Cm,<cp>
     // Decode the operands
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 21) & 0x7;
-    uint32_t rd = *registers[(opcode >> 12) & 0xF];
+    uint32_t rd = registers[(opcode >> 12) & 0xF];
     uint8_t cn = (opcode >> 16) & 0xF;
     uint8_t cm = (opcode & 0xF);
     uint8_t cp = (opcode >> 5) & 0x7;
@@ -1165,8 +1157,8 @@ int ArmInterp::mrrc(uint32_t opcode) { // MRRC Pn,<cpopc>,Rd,Rn,Cm
     // Decode the operands
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 4) & 0xF;
-    uint32_t *rd = registers[(opcode >> 12) & 0xF];
-    uint32_t *rn = registers[(opcode >> 16) & 0xF];
+    uint32_t *rd = &registers[(opcode >> 12) & 0xF];
+    uint32_t *rn = &registers[(opcode >> 16) & 0xF];
     uint8_t cm = (opcode & 0xF);
 
     // Read a double value from a coprocessor if it exists
@@ -1194,8 +1186,8 @@ int ArmInterp::mcrr(uint32_t opcode) { // MCRR Pn,<cpopc>,Rd,Rn,Cm
     // Decode the operands
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 4) & 0xF;
-    uint32_t rd = *registers[(opcode >> 12) & 0xF];
-    uint32_t rn = *registers[(opcode >> 16) & 0xF];
+    uint32_t rd = registers[(opcode >> 12) & 0xF];
+    uint32_t rn = registers[(opcode >> 16) & 0xF];
     uint8_t cm = (opcode & 0xF);
 
     // Write a double value to a coprocessor if it exists
@@ -1224,7 +1216,7 @@ int ArmInterp::ldc(uint32_t opcode) { // LDC Pn,Cd,<Address>
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 21) & 0xF;
     uint8_t cd = (opcode >> 12) & 0xF;
-    uint32_t *rn = registers[(opcode >> 16) & 0xF];
+    uint32_t *rn = &registers[(opcode >> 16) & 0xF];
     uint8_t ofs = (opcode & 0xFF);
 
     // Perform a memory load on a coprocessor if it exists
@@ -1253,7 +1245,7 @@ int ArmInterp::stc(uint32_t opcode) { // STC Pn,Cd,<Address>
     uint8_t pn = (opcode >> 8) & 0xF;
     uint8_t cpopc = (opcode >> 21) & 0xF;
     uint8_t cd = (opcode >> 12) & 0xF;
-    uint32_t *rn = registers[(opcode >> 16) & 0xF];
+    uint32_t *rn = &registers[(opcode >> 16) & 0xF];
     uint8_t ofs = (opcode & 0xFF);
 
     // Perform a memory store on a coprocessor if it exists
@@ -1309,9 +1301,9 @@ int ArmInterp::cdp(uint32_t opcode) { // CDP Pn,<cpopc>,Cd,Cn,Cm,<cp>
 
 int ArmInterp::swpb(uint32_t opcode) { // SWPB Rd,Rm,[Rn]
     // Swap byte
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[opcode & 0xF];
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint8_t>(id, op2);
     core.cp15.write<uint8_t>(id, op2, op1);
     return 2;
@@ -1319,9 +1311,9 @@ int ArmInterp::swpb(uint32_t opcode) { // SWPB Rd,Rm,[Rn]
 
 int ArmInterp::swp(uint32_t opcode) { // SWP Rd,Rm,[Rn]
     // Swap word
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[opcode & 0xF];
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     *op0 = core.cp15.read<uint32_t>(id, op2);
     core.cp15.write<uint32_t>(id, op2, op1);
 
@@ -1336,13 +1328,14 @@ int ArmInterp::swp(uint32_t opcode) { // SWP Rd,Rm,[Rn]
 int ArmInterp::ldrexb(uint32_t opcode) { // LDREXB Rd,[Rn]
     // Load byte exclusively
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     excValue = *op0 = core.cp15.read<uint8_t>(id, excAddress = op1);
     exclusive = true;
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -1351,9 +1344,10 @@ int ArmInterp::ldrexb(uint32_t opcode) { // LDREXB Rd,[Rn]
 int ArmInterp::strexb(uint32_t opcode) { // STREXB Rd,Rm,[Rn]
     // Store byte exclusively, passing if the data is loaded and unchanged
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[opcode & 0xF];
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     if (*op0 = !exclusive || excAddress != op2 || excValue != core.cp15.read<uint8_t>(id, op2)) return 1;
     core.cp15.write<uint8_t>(id, op2, op1);
 
@@ -1367,13 +1361,14 @@ int ArmInterp::strexb(uint32_t opcode) { // STREXB Rd,Rm,[Rn]
 int ArmInterp::ldrexh(uint32_t opcode) { // LDREXH Rd,[Rn]
     // Load half-word exclusively
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     excValue = *op0 = core.cp15.read<uint16_t>(id, excAddress = op1);
     exclusive = true;
 
     // Handle pipelining
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     flushPipeline();
     return 5;
 }
@@ -1381,9 +1376,10 @@ int ArmInterp::ldrexh(uint32_t opcode) { // LDREXH Rd,[Rn]
 int ArmInterp::strexh(uint32_t opcode) { // STREXH Rd,Rm,[Rn]
     // Store half-word exclusively, passing if the data is loaded and unchanged
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[opcode & 0xF];
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     if (*op0 = !exclusive || excAddress != op2 || excValue != core.cp15.read<uint16_t>(id, op2)) return 1;
     core.cp15.write<uint16_t>(id, op2, op1);
 
@@ -1397,13 +1393,14 @@ int ArmInterp::strexh(uint32_t opcode) { // STREXH Rd,Rm,[Rn]
 int ArmInterp::ldrex(uint32_t opcode) { // LDREX Rd,[Rn]
     // Load word exclusively
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     excValue = *op0 = core.cp15.read<uint32_t>(id, excAddress = op1);
     exclusive = true;
 
     // Handle pipelining and THUMB switching
-    if (op0 != registers[15]) return 1;
+    if (op0 != &registers[15]) return 1;
     cpsr |= (*op0 & 0x1) << 5;
     flushPipeline();
     return 5;
@@ -1412,9 +1409,10 @@ int ArmInterp::ldrex(uint32_t opcode) { // LDREX Rd,[Rn]
 int ArmInterp::strex(uint32_t opcode) { // STREX Rd,Rm,[Rn]
     // Store word exclusively, passing if the data is loaded and unchanged
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t op1 = *registers[opcode & 0xF];
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t op1 = registers[opcode & 0xF];
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     if (*op0 = !exclusive || excAddress != op2 || excValue != core.cp15.read<uint32_t>(id, op2)) return 1;
     core.cp15.write<uint32_t>(id, op2, op1);
 
@@ -1428,9 +1426,10 @@ int ArmInterp::strex(uint32_t opcode) { // STREX Rd,Rm,[Rn]
 int ArmInterp::ldrexd(uint32_t opcode) { // LDREXD Rd,[Rn]
     // Load double words exclusively
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    if (op0 == registers[15]) return 1;
-    uint32_t op1 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    if (op0 == &registers[15]) return 1;
+    uint32_t op1 = registers[(opcode >> 16) & 0xF];
     excValue = op0[0] = core.cp15.read<uint32_t>(id, excAddress = op1);
     excValue |= uint64_t(op0[1] = core.cp15.read<uint32_t>(id, op1 + 4)) << 32;
     exclusive = true;
@@ -1440,10 +1439,11 @@ int ArmInterp::ldrexd(uint32_t opcode) { // LDREXD Rd,[Rn]
 int ArmInterp::strexd(uint32_t opcode) { // STREXD Rd,Rm,[Rn]
     // Store double words exclusively, passing if the data is loaded and unchanged
     if (id == ARM9) return unkArm(opcode); // ARM11-exclusive
-    uint32_t *op0 = registers[(opcode >> 12) & 0xF];
-    uint32_t *op1 = registers[opcode & 0xF];
-    if (op1 == registers[15]) return 1;
-    uint32_t op2 = *registers[(opcode >> 16) & 0xF];
+    CoreLock lock(core);
+    uint32_t *op0 = &registers[(opcode >> 12) & 0xF];
+    uint32_t *op1 = &registers[opcode & 0xF];
+    if (op1 == &registers[15]) return 1;
+    uint32_t op2 = registers[(opcode >> 16) & 0xF];
     if (*op0 = !exclusive || excAddress != op2 || excValue != (core.cp15.read<uint32_t>(id, op2)
         | (uint64_t(core.cp15.read<uint32_t>(id, op2 + 4)) << 32))) return 1;
     core.cp15.write<uint32_t>(id, op2, op1[0]);
@@ -1464,63 +1464,63 @@ int ArmInterp::clrex(uint32_t opcode) { // CLREX
 
 int ArmInterp::ldrsbRegT(uint16_t opcode) { // LDRSB Rd,[Rb,Ro]
     // Signed byte load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     *op0 = (int8_t)core.cp15.read<uint8_t>(id, op1 + op2);
     return 1;
 }
 
 int ArmInterp::ldrshRegT(uint16_t opcode) { // LDRSH Rd,[Rb,Ro]
     // Signed half-word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     *op0 = (int16_t)core.cp15.read<uint16_t>(id, op1 += op2);
     return 1;
 }
 
 int ArmInterp::ldrbRegT(uint16_t opcode) { // LDRB Rd,[Rb,Ro]
     // Byte load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     *op0 = core.cp15.read<uint8_t>(id, op1 + op2);
     return 1;
 }
 
 int ArmInterp::strbRegT(uint16_t opcode) { // STRB Rd,[Rb,Ro]
     // Byte write, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     core.cp15.write<uint8_t>(id, op1 + op2, op0);
     return 1;
 }
 
 int ArmInterp::ldrhRegT(uint16_t opcode) { // LDRH Rd,[Rb,Ro]
     // Half-word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     *op0 = core.cp15.read<uint16_t>(id, op1 += op2);
     return 1;
 }
 
 int ArmInterp::strhRegT(uint16_t opcode) { // STRH Rd,[Rb,Ro]
     // Half-word write, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     core.cp15.write<uint16_t>(id, op1 + op2, op0);
     return 1;
 }
 
 int ArmInterp::ldrRegT(uint16_t opcode) { // LDR Rd,[Rb,Ro]
     // Word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     *op0 = core.cp15.read<uint32_t>(id, op1 += op2);
 
     // Rotate misaligned reads on ARM9
@@ -1533,17 +1533,17 @@ int ArmInterp::ldrRegT(uint16_t opcode) { // LDR Rd,[Rb,Ro]
 
 int ArmInterp::strRegT(uint16_t opcode) { // STR Rd,[Rb,Ro]
     // Word write, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
-    uint32_t op2 = *registers[(opcode >> 6) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
+    uint32_t op2 = registers[(opcode >> 6) & 0x7];
     core.cp15.write<uint32_t>(id, op1 + op2, op0);
     return 1;
 }
 
 int ArmInterp::ldrbImm5T(uint16_t opcode) { // LDRB Rd,[Rb,#i]
     // Byte load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode & 0x07C0) >> 6;
     *op0 = core.cp15.read<uint8_t>(id, op1 + op2);
     return 1;
@@ -1551,8 +1551,8 @@ int ArmInterp::ldrbImm5T(uint16_t opcode) { // LDRB Rd,[Rb,#i]
 
 int ArmInterp::strbImm5T(uint16_t opcode) { // STRB Rd,[Rb,#i]
     // Byte store, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode & 0x07C0) >> 6;
     core.cp15.write<uint8_t>(id, op1 + op2, op0);
     return 1;
@@ -1560,8 +1560,8 @@ int ArmInterp::strbImm5T(uint16_t opcode) { // STRB Rd,[Rb,#i]
 
 int ArmInterp::ldrhImm5T(uint16_t opcode) { // LDRH Rd,[Rb,#i]
     // Half-word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode >> 5) & 0x3E;
     *op0 = core.cp15.read<uint16_t>(id, op1 += op2);
     return 1;
@@ -1569,8 +1569,8 @@ int ArmInterp::ldrhImm5T(uint16_t opcode) { // LDRH Rd,[Rb,#i]
 
 int ArmInterp::strhImm5T(uint16_t opcode) { // STRH Rd,[Rb,#i]
     // Half-word store, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode >> 5) & 0x3E;
     core.cp15.write<uint16_t>(id, op1 + op2, op0);
     return 1;
@@ -1578,8 +1578,8 @@ int ArmInterp::strhImm5T(uint16_t opcode) { // STRH Rd,[Rb,#i]
 
 int ArmInterp::ldrImm5T(uint16_t opcode) { // LDR Rd,[Rb,#i]
     // Word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t *op0 = &registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode >> 4) & 0x7C;
     *op0 = core.cp15.read<uint32_t>(id, op1 += op2);
 
@@ -1593,8 +1593,8 @@ int ArmInterp::ldrImm5T(uint16_t opcode) { // LDR Rd,[Rb,#i]
 
 int ArmInterp::strImm5T(uint16_t opcode) { // STR Rd,[Rb,#i]
     // Word store, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[opcode & 0x7];
-    uint32_t op1 = *registers[(opcode >> 3) & 0x7];
+    uint32_t op0 = registers[opcode & 0x7];
+    uint32_t op1 = registers[(opcode >> 3) & 0x7];
     uint32_t op2 = (opcode >> 4) & 0x7C;
     core.cp15.write<uint32_t>(id, op1 + op2, op0);
     return 1;
@@ -1602,8 +1602,8 @@ int ArmInterp::strImm5T(uint16_t opcode) { // STR Rd,[Rb,#i]
 
 int ArmInterp::ldrPcT(uint16_t opcode) { // LDR Rd,[PC,#i]
     // PC-relative word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[(opcode >> 8) & 0x7];
-    uint32_t op1 = *registers[15] & ~0x3;
+    uint32_t *op0 = &registers[(opcode >> 8) & 0x7];
+    uint32_t op1 = registers[15] & ~0x3;
     uint32_t op2 = (opcode & 0xFF) << 2;
     *op0 = core.cp15.read<uint32_t>(id, op1 += op2);
 
@@ -1617,8 +1617,8 @@ int ArmInterp::ldrPcT(uint16_t opcode) { // LDR Rd,[PC,#i]
 
 int ArmInterp::ldrSpT(uint16_t opcode) { // LDR Rd,[SP,#i]
     // SP-relative word load, pre-adjust without writeback (THUMB)
-    uint32_t *op0 = registers[(opcode >> 8) & 0x7];
-    uint32_t op1 = *registers[13];
+    uint32_t *op0 = &registers[(opcode >> 8) & 0x7];
+    uint32_t op1 = registers[13];
     uint32_t op2 = (opcode & 0xFF) << 2;
     *op0 = core.cp15.read<uint32_t>(id, op1 += op2);
 
@@ -1632,8 +1632,8 @@ int ArmInterp::ldrSpT(uint16_t opcode) { // LDR Rd,[SP,#i]
 
 int ArmInterp::strSpT(uint16_t opcode) { // STR Rd,[SP,#i]
     // SP-relative word store, pre-adjust without writeback (THUMB)
-    uint32_t op0 = *registers[(opcode >> 8) & 0x7];
-    uint32_t op1 = *registers[13];
+    uint32_t op0 = registers[(opcode >> 8) & 0x7];
+    uint32_t op1 = registers[13];
     uint32_t op2 = (opcode & 0xFF) << 2;
     core.cp15.write<uint32_t>(id, op1 + op2, op0);
     return 1;
@@ -1642,13 +1642,9 @@ int ArmInterp::strSpT(uint16_t opcode) { // STR Rd,[SP,#i]
 int ArmInterp::ldmiaT(uint16_t opcode) { // LDMIA Rb!,<Rlist>
     // Block load, post-increment with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF];
-    uint32_t *op0 = registers[(opcode >> 8) & 0x7];
+    uint32_t *op0 = &registers[(opcode >> 8) & 0x7];
     uint32_t address = (*op0 += (m << 2)) - (m << 2);
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, address);
-        address += 4;
-    }
+    loadBlock(address, opcode & 0xFF, m);
     return m + (m < 2);
 }
 
@@ -1656,52 +1652,36 @@ int ArmInterp::stmiaT(uint16_t opcode) { // STMIA Rb!,<Rlist>
     // Block store, post-increment with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF];
     uint8_t op0 = (opcode >> 8) & 0x7;
-    uint32_t address = *registers[op0];
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, *registers[i]);
-        address += 4;
-    }
-    *registers[op0] = address;
+    uint32_t address = registers[op0];
+    storeBlock(address, opcode & 0xFF, m);
+    registers[op0] = address + (m << 2);
     return m + (m < 2);
 }
 
 int ArmInterp::popT(uint16_t opcode) { // POP <Rlist>
     // SP-relative block load, post-increment with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF];
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, *registers[13]);
-        *registers[13] += 4;
-    }
+    loadBlock(registers[13], opcode & 0xFF, m);
+    registers[13] += (m << 2);
     return m + (m < 2);
 }
 
 int ArmInterp::pushT(uint16_t opcode) { // PUSH <Rlist>
     // SP-relative block store, pre-decrement with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF];
-    uint32_t address = (*registers[13] -= (m << 2));
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, *registers[i]);
-        address += 4;
-    }
+    uint32_t address = (registers[13] -= (m << 2));
+    storeBlock(address, opcode & 0xFF, m);
     return m + (m < 2);
 }
 
 int ArmInterp::popPcT(uint16_t opcode) { // POP <Rlist>,PC
     // SP-relative block load, post-increment with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF] + 1;
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        *registers[i] = core.cp15.read<uint32_t>(id, *registers[13]);
-        *registers[13] += 4;
-    }
+    loadBlock(registers[13], (opcode & 0xFF) | BIT(15), m);
+    registers[13] += (m << 2);
 
-    // Load the program counter and handle pipelining
-    *registers[15] = core.cp15.read<uint32_t>(id, *registers[13]);
-    *registers[13] += 4;
-    cpsr &= ~((~(*registers[15]) & 0x1) << 5);
+    // Handle pipelining and THUMB switching
+    cpsr &= ~((~(registers[15]) & 0x1) << 5);
     flushPipeline();
     return m + 4;
 }
@@ -1709,14 +1689,7 @@ int ArmInterp::popPcT(uint16_t opcode) { // POP <Rlist>,PC
 int ArmInterp::pushLrT(uint16_t opcode) { // PUSH <Rlist>,LR
     // SP-relative block store, pre-decrement with writeback (THUMB)
     uint8_t m = bitCount[opcode & 0xFF] + 1;
-    uint32_t address = (*registers[13] -= (m << 2));
-    for (int i = 0; i < 8; i++) {
-        if (~opcode & BIT(i)) continue;
-        core.cp15.write<uint32_t>(id, address, *registers[i]);
-        address += 4;
-    }
-
-    // Store the link register
-    core.cp15.write<uint32_t>(id, address, *registers[14]);
+    uint32_t address = (registers[13] -= (m << 2));
+    storeBlock(address, (opcode & 0xFF) | BIT(14), m);
     return m + (m < 2);
 }
@@ -0,0 +1,502 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include "../core.h"
+
+#ifdef WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#define BUFFER_SIZE 0x2000000
+#define MAX_BLOCK 64
+#define MAX_CODE 0x4000
+
+// Registers that hold the second and third function arguments in the host calling convention
+#ifdef WINDOWS
+#define ARG2 2 // EDX
+#define ARG3 8 // R8D
+#else
+#define ARG2 6 // ESI
+#define ARG3 2 // EDX
+#endif
+
+ArmJit::ArmJit(Core &core, ArmInterp &cpu, bool native): core(core), cpu(cpu), native(native) {
+    // Track shared time per instruction unless CPUs run in parallel, where it stays at the slice start
+    sharedTime = !(core.threadedArm11 || core.threadedArm9 || core.threadedDsp);
+
+    // Allocate a regular buffer for pre-decoded blocks if not compiling to host code
+    if (!native) {
+        buffer = ptr = new uint8_t[BUFFER_SIZE];
+        return;
+    }
+
+    // Allocate a buffer for compiled code, leaving the interpreter to run if it fails
+    // It's never writable and executable at once, and only switches to writable while a block is compiled
+#ifdef WINDOWS
+    buffer = (uint8_t*)VirtualAlloc(nullptr, BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READ);
+#else
+    void *mem = mmap(nullptr, BUFFER_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    buffer = (mem == MAP_FAILED) ? nullptr : (uint8_t*)mem;
+#endif
+    if (!buffer) LOG_WARN("Failed to allocate JIT memory for ARM11 core %d\n", cpu.id);
+    ptr = buffer;
+}
+
+ArmJit::~ArmJit() {
+    // Free the code buffer
+    if (!native) {
+        delete[] buffer;
+        return;
+    }
+    if (!buffer) return;
+#ifdef WINDOWS
+    VirtualFree(buffer, 0, MEM_RELEASE);
+#else
+    munmap(buffer, BUFFER_SIZE);
+#endif
+}
+
+void ArmJit::reset() {
+    // Discard all compiled blocks
+    blocks.clear();
+    memset(cache, 0, sizeof(cache));
+    ptr = buffer;
+}
+
+bool ArmJit::runBlock() {
+    // Get a host pointer to the next instruction, leaving unmapped code to the interpreter
+    bool thumb = (cpu.cpsr & BIT(5));
+    uint32_t address = cpu.registers[15] - (thumb ? 2 : 4);
+    uint8_t *host = core.cp15.getReadPtr(cpu.id, address);
+    if (!host || !buffer) {
+        cpu.refillPipeline();
+        return false;
+    }
+    host += (address & 0xFFF);
+    address |= thumb;
+
+    // Look up the block in the fast cache, then in the full map, and compile it if it doesn't exist
+    JitBlock *&block = cache[(address >> 1) & 0x3FFF];
+    if (!block || block->host != host || block->address != address) {
+        std::unordered_map<uintptr_t, JitBlock>::iterator it = blocks.find(uintptr_t(host) | thumb);
+        block = (it != blocks.end() && it->second.address == address) ? &it->second : compile(address, host);
+    }
+
+    // Recompile the block if its page was written and its code changed, or revalidate it otherwise
+    // The page is watched again before comparing, so writes that land during the check aren't missed
+    if (*block->memTag != block->tag) {
+        uint32_t tag = *(block->memTag = core.cp15.getMemTag(cpu.id, address));
+        if (memcmp(block->copy, host, block->size))
+            block = compile(address, host);
+        else
+            block->tag = tag;
+    }
+
+    // Run the block natively or through its pre-decoded handlers, updating the CPU state as if it was interpreted
+    if (native)
+        ((void(*)())block->code)();
+    else
+        runCached(*block);
+    return true;
+}
+
+void ArmJit::runCached(JitBlock &block) {
+    // Run pre-decoded instructions in order, with the program counter they would see in the pipeline
+    CachedOp *ops = (CachedOp*)block.code;
+    bool thumb = (block.address & 0x1);
+    uint32_t pc = (block.address & ~0x1) + (thumb ? 4 : 8);
+    for (uint32_t i = 0; i < block.count; i++, pc += (thumb ? 2 : 4)) {
+        // Update shared time so tasks scheduled by the instruction are timed correctly
+        if (sharedTime) core.globalCycles = cpu.cycles;
+        cpu.registers[15] = pc;
+        cpu.instructions++;
+
+        // Execute an instruction based on its condition, leaving the block if it jumped
+        if (ops[i].cond != 0xE0) cpu.updateFlags();
+        if (!ArmInterp::condition[ops[i].cond | (cpu.cpsr >> 28)]) {
+            cpu.cycles++;
+            continue;
+        }
+        cpu.cycles += COUNT_OP(*ops[i].stat, ops[i].opcode,
+            thumb ? (cpu.*ops[i].thumb)(ops[i].opcode) : (cpu.*ops[i].arm)(ops[i].opcode));
+        if (cpu.registers[15] != pc) return;
+    }
+
+    // Jump to the next instruction after falling through the end of the block
+    exitBlock(&cpu, pc - (thumb ? 4 : 8));
+}
+
+void ArmJit::setWritable(uint8_t *code, bool writable) {
+    // Switch the pages a block starting at the given code can be compiled into between writable and executable
+    // Blocks are limited in length, so this only covers a few pages to keep the system calls cheap
+    uint8_t *start = buffer + ((code - buffer) & ~0xFFF);
+    size_t size = std::min<size_t>(MAX_CODE + 0x1000, buffer + BUFFER_SIZE - start);
+#ifdef WINDOWS
+    DWORD old;
+    VirtualProtect(start, size, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &old);
+#else
+    mprotect(start, size, writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC));
+#endif
+}
+
+int ArmJit::callArm(ArmInterp *cpu, uint32_t opcode) {
+    // Run an ARM handler for compiled code, since member function pointers have no portable code address
+    if ((opcode >> 28) == 0xF) return cpu->handleReserved(opcode);
+    return (cpu->*ArmInterp::armInstrs[((opcode >> 16) & 0xFF0) | ((opcode >> 4) & 0xF)])(opcode);
+}
+
+int ArmJit::callThumb(ArmInterp *cpu, uint32_t opcode) {
+    // Run a THUMB handler for compiled code
+    return (cpu->*ArmInterp::thumbInstrs[(opcode >> 6) & 0x3FF])(opcode);
+}
+
+int ArmJit::callResolve(ArmInterp *cpu, uint32_t opcode) {
+    // Resolve lazy flags for compiled code
+    cpu->resolveFlags();
+    return 0;
+}
+
+uint32_t ArmJit::loadWord(ArmInterp *cpu, uint32_t address) {
+    // Read a word for compiled code, which only runs on ARM11 cores and doesn't rotate misaligned reads
+    return cpu->core.cp15.read<uint32_t>(cpu->id, address);
+}
+
+void ArmJit::storeWord(ArmInterp *cpu, uint32_t address, uint32_t value) {
+    // Write a word for compiled code
+    cpu->core.cp15.write<uint32_t>(cpu->id, address, value);
+}
+
+void ArmJit::exitBlock(ArmInterp *cpu, uint32_t address) {
+    // Jump to the next instruction after falling through the end of a block
+    cpu->registers[15] = address;
+    cpu->flushPipeline();
+}
+
+void ArmJit::emit32(uint32_t value) {
+    // Write a 32-bit value to the code buffer
+    memcpy(ptr, &value, sizeof(value));
+    ptr += sizeof(value);
+}
+
+void ArmJit::emit64(uint64_t value) {
+    // Write a 64-bit value to the code buffer
+    memcpy(ptr, &value, sizeof(value));
+    ptr += sizeof(value);
+}
+
+void ArmJit::emitDisp(uint8_t op, uint8_t reg, void *field) {
+    // Write an opcode that accesses a CPU field relative to RBX, which holds the CPU pointer
+    if (reg & 0x8) emit8(0x44); // REX.R
+    emit8(op);
+    emit8(0x83 | ((reg & 0x7) << 3));
+    emit32((uint8_t*)field - (uint8_t*)&cpu);
+}
+
+void ArmJit::emitCall(void *func, uint32_t arg) {
+    // Pass an argument along with the CPU pointer
+    emit8(0xB8 | ARG2), emit32(arg); // mov arg2,arg
+    emitCall(func);
+}
+
+void ArmJit::emitCall(void *func) {
+    // Pass the CPU pointer as the first argument based on the host calling convention
+#ifdef WINDOWS
+    emit8(0x48), emit8(0x89), emit8(0xD9); // mov rcx,rbx
+#else
+    emit8(0x48), emit8(0x89), emit8(0xDF); // mov rdi,rbx
+#endif
+
+    // Call the function through an absolute address
+    emit8(0x48), emit8(0xB8), emit64(uintptr_t(func)); // mov rax,func
+    emit8(0xFF), emit8(0xD0); // call rax
+}
+
+void ArmJit::emitTransfer(bool load, uint8_t rd, int8_t rn, uint32_t offset) {
+    // Put the address in the second argument, using the offset alone if it's PC-relative and already resolved
+    if (rn < 0) {
+        emit8(0xB8 | ARG2), emit32(offset); // mov arg2,offset
+    }
+    else {
+        emitDisp(0x8B, ARG2, &cpu.registers[rn]); // mov arg2,[rn]
+        if (offset) emit8(0x81), emit8(0xC0 | ARG2), emit32(offset); // add arg2,offset
+    }
+
+    // Read a word into the destination register, or pass the source register along to be written
+    if (load) {
+        emitCall((void*)&ArmJit::loadWord);
+        emitDisp(0x89, 0, &cpu.registers[rd]); // mov [rd],eax
+    }
+    else {
+        emitDisp(0x8B, ARG3, &cpu.registers[rd]); // mov arg3,[rd]
+        emitCall((void*)&ArmJit::storeWord);
+    }
+}
+
+uint8_t ArmJit::emitNative(CachedOp &op, uint32_t pc, bool thumb) {
+    // Compile simple THUMB moves, additions, and word transfers to host code, returning their type
+    // Anything that sets flags, shifts by register, or writes the program counter is left to its handler
+    uint32_t opcode = op.opcode;
+    if (thumb) {
+        uint8_t rd = (opcode >> 8) & 0x7;
+        if ((opcode & 0xF000) == 0x6000) // LDR/STR Rd,[Rb,#i]
+            emitTransfer(opcode & BIT(11), opcode & 0x7, (opcode >> 3) & 0x7, (opcode >> 4) & 0x7C);
+        else if ((opcode & 0xF000) == 0x9000) // LDR/STR Rd,[SP,#i]
+            emitTransfer(opcode & BIT(11), rd, 13, (opcode & 0xFF) << 2);
+        else if ((opcode & 0xF800) == 0x4800) // LDR Rd,[PC,#i]
+            emitTransfer(true, rd, -1, (pc & ~0x3) + ((opcode & 0xFF) << 2));
+        else if ((opcode & 0xFF00) == 0x4600 && (opcode & 0x87) != 0x87) { // MOV Rd,Rs
+            emitDisp(0x8B, 0, &cpu.registers[(opcode >> 3) & 0xF]); // mov eax,[rs]
+            emitDisp(0x89, 0, &cpu.registers[((opcode >> 4) & 0x8) | (opcode & 0x7)]); // mov [rd],eax
+        }
+        else if ((opcode & 0xF800) == 0xA000) { // ADD Rd,PC,#i
+            emitDisp(0xC7, 0, &cpu.registers[rd]), emit32((pc & ~0x3) + ((opcode & 0xFF) << 2)); // mov dword [rd],imm
+        }
+        else if ((opcode & 0xF800) == 0xA800) { // ADD Rd,SP,#i
+            emitDisp(0x8B, 0, &cpu.registers[13]); // mov eax,[sp]
+            emit8(0x05), emit32((opcode & 0xFF) << 2); // add eax,imm
+            emitDisp(0x89, 0, &cpu.registers[rd]); // mov [rd],eax
+        }
+        else if ((opcode & 0xFF00) == 0xB000) { // ADD SP,#i
+            uint32_t imm = ((opcode & BIT(7)) ? (0 - (opcode & 0x7F)) : (opcode & 0x7F)) << 2;
+            emitDisp(0x81, 0, &cpu.registers[13]), emit32(imm); // add dword [sp],imm
+        }
+        else {
+            return NATIVE_NONE;
+        }
+    }
+    else if ((opcode & 0x0F600000) == 0x05000000 && ((opcode >> 12) & 0xF) != 0xF) { // LDR/STR Rd,[Rn,#i]
+        // Resolve PC-relative addresses when compiling, since the program counter is known
+        uint8_t rn = (opcode >> 16) & 0xF;
+        uint32_t offset = (opcode & BIT(23)) ? (opcode & 0xFFF) : (0 - (opcode & 0xFFF));
+        emitTransfer(opcode & BIT(20), (opcode >> 12) & 0xF, (rn == 0xF) ? -1 : rn, offset + ((rn == 0xF) ? pc : 0));
+    }
+    else if ((opcode & 0x0C100000) == 0x00000000 && ((opcode >> 12) & 0xF) != 0xF) { // ALU without flags
+        // Only handle logical operations, addition, and subtraction, with Rn and Rm not being the program counter
+        uint8_t alu = (opcode >> 21) & 0xF;
+        bool move = (alu == 0xD || alu == 0xF);
+        if ((alu >= 0x5 && alu <= 0xB) || (!move && ((opcode >> 16) & 0xF) == 0xF)) return NATIVE_NONE;
+
+        if (opcode & BIT(25)) {
+            // Rotate an immediate second operand when compiling
+            uint32_t imm = opcode & 0xFF;
+            uint8_t shift = (opcode >> 7) & 0x1E;
+            emit8(0xB9), emit32(shift ? ((imm << (32 - shift)) | (imm >> shift)) : imm); // mov ecx,imm
+        }
+        else {
+            // Load a register second operand and shift it by an immediate, leaving RRX and shifts of 32 out
+            static const uint8_t shifts[] = { 0xE1, 0xE9, 0xF9, 0xC9 }; // shl, shr, sar, ror
+            uint8_t type = (opcode >> 5) & 0x3, amount = (opcode >> 7) & 0x1F;
+            if ((opcode & BIT(4)) || (opcode & 0xF) == 0xF || (type && !amount)) return NATIVE_NONE;
+            emitDisp(0x8B, 1, &cpu.registers[opcode & 0xF]); // mov ecx,[rm]
+            if (amount) emit8(0xC1), emit8(shifts[type]), emit8(amount); // shift ecx,amount
+        }
+
+        // Apply the operation with Rn in EAX and the second operand in ECX, leaving the result in EAX
+        if (!move) emitDisp(0x8B, 0, &cpu.registers[(opcode >> 16) & 0xF]); // mov eax,[rn]
+        switch (alu) {
+            case 0x0: emit8(0x21), emit8(0xC8); break; // and eax,ecx
+            case 0x1: emit8(0x31), emit8(0xC8); break; // xor eax,ecx
+            case 0x2: emit8(0x29), emit8(0xC8); break; // sub eax,ecx
+            case 0x3: emit8(0x29), emit8(0xC1), emit8(0x89), emit8(0xC8); break; // sub ecx,eax; mov eax,ecx
+            case 0x4: emit8(0x01), emit8(0xC8); break; // add eax,ecx
+            case 0xC: emit8(0x09), emit8(0xC8); break; // or eax,ecx
+            case 0xD: emit8(0x89), emit8(0xC8); break; // mov eax,ecx
+            case 0xE: emit8(0xF7), emit8(0xD1), emit8(0x21), emit8(0xC8); break; // not ecx; and eax,ecx
+            case 0xF: emit8(0xF7), emit8(0xD1), emit8(0x89), emit8(0xC8); break; // not ecx; mov eax,ecx
+        }
+        emitDisp(0x89, 0, &cpu.registers[(opcode >> 12) & 0xF]); // mov [rd],eax
+    }
+    else {
+        return NATIVE_NONE;
+    }
+
+    // Report the single cycle these instructions take, like their handlers
+    emit8(0xB8), emit32(1); // mov eax,1
+    bool transfer = thumb ? ((opcode & 0xF000) == 0x6000 || (opcode & 0xF000) == 0x9000 ||
+        (opcode & 0xF800) == 0x4800) : ((opcode & 0x0C000000) == 0x04000000);
+    return transfer ? NATIVE_TRANSFER : NATIVE_ALU;
+}
+
+void ArmJit::emitOp(CachedOp &op, uint32_t pc, bool thumb, std::vector<uint8_t*> &exits) {
+    // Update shared time so tasks scheduled by the instruction are timed correctly
+    if (sharedTime) {
+        emit8(0x48), emitDisp(0x8B, 0, &cpu.cycles); // mov rax,[cycles]
+        emit8(0x48), emit8(0xB9), emit64(uintptr_t(&core.globalCycles)); // mov rcx,globalCycles
+        emit8(0x48), emit8(0x89), emit8(0x01); // mov [rcx],rax
+    }
+
+    // Set the program counter and count the instruction
+    emitDisp(0xC7, 0, &cpu.registers[15]), emit32(pc); // mov dword [pc],pc
+    emit8(0x48), emitDisp(0xFF, 0, &cpu.instructions); // inc qword [instructions]
+
+    // Look up the condition in the interpreter's table if it isn't always true, adding a cycle and skipping if false
+    uint8_t *skip = nullptr;
+    if (op.cond != 0xE0) {
+        // Resolve lazy flags first if an earlier instruction left them pending
+        emitDisp(0x80, 7, &cpu.flagType), emit8(FLAGS_NONE); // cmp byte [flagType],0
+        emit8(0x74); // je resolved
+        uint8_t *resolved = ptr++;
+        emitCall((void*)&ArmJit::callResolve, 0);
+        *resolved = ptr - resolved - 1;
+
+        emitDisp(0x8B, 0, &cpu.cpsr); // mov eax,[cpsr]
+        emit8(0xC1), emit8(0xE8), emit8(28); // shr eax,28
+        emit8(0x48), emit8(0xB9), emit64(uintptr_t(&ArmInterp::condition[op.cond])); // mov rcx,cond
+        emit8(0x80), emit8(0x3C), emit8(0x01), emit8(0x00); // cmp byte [rcx+rax],0
+        emit8(0x75), emit8(0x0C); // jne +12
+        emit8(0x48), emitDisp(0xFF, 0, &cpu.cycles); // inc qword [cycles]
+        emit8(0xE9), skip = ptr, emit32(0); // jmp next
+    }
+
+    // Run the instruction as host code if possible, or call its handler, and add its cycles
+    uint8_t type = emitNative(op, pc, thumb);
+    if (type == NATIVE_NONE)
+        emitCall(thumb ? (void*)&ArmJit::callThumb : (void*)&ArmJit::callArm, op.opcode);
+    emit8(0x48), emit8(0x63), emit8(0xC0); // movsxd rax,eax
+    emit8(0x48), emitDisp(0x01, 0, &cpu.cycles); // add [cycles],rax
+
+#if OP_STATS
+    // Count the handler and its cycles, remembering the opcode as an example
+    emit8(0x48), emit8(0xB9), emit64(uintptr_t(op.stat)); // mov rcx,stat
+    emit8(0x48), emit8(0xFF), emit8(0x01); // inc qword [rcx]
+    emit8(0x48), emit8(0x01), emit8(0x41), emit8(offsetof(OpStat, cycles)); // add [rcx+cycles],rax
+    emit8(0xC7), emit8(0x41), emit8(offsetof(OpStat, opcode)), emit32(op.opcode); // mov dword [rcx+opcode],opcode
+#endif
+
+    // Leave the block if the instruction jumped, which also covers exceptions and anything memory access changed
+    if (type != NATIVE_ALU) {
+        emitDisp(0x81, 7, &cpu.registers[15]), emit32(pc); // cmp dword [pc],pc
+        emit8(0x0F), emit8(0x85), exits.push_back(ptr), emit32(0); // jne exit
+    }
+
+    // Point a false condition to the next instruction
+    if (skip) {
+        uint32_t offset = ptr - (skip + 4);
+        memcpy(skip, &offset, sizeof(offset));
+    }
+}
+
+JitBlock *ArmJit::compile(uint32_t address, uint8_t *host) {
+    // Start fresh if the code buffer is close to full, and keep blocks aligned
+    if (ptr - buffer > BUFFER_SIZE - 0x10000)
+        reset();
+    ptr = buffer + ((ptr - buffer + 7) & ~0x7);
+    if (native) setWritable(ptr, true);
+
+    // Set up a block, snapshotting its page tag before reading code
+    bool thumb = (address & 0x1);
+    JitBlock &block = blocks[uintptr_t(host) | thumb];
+    block.address = address;
+    block.host = host;
+    block.memTag = core.cp15.getMemTag(cpu.id, address);
+    block.tag = *block.memTag;
+    block.size = block.count = 0;
+    block.code = ptr;
+    address &= ~0x1;
+
+    // Save RBX and load the CPU pointer into it when compiling, keeping the stack aligned for calls
+    std::vector<uint8_t*> exits;
+    if (native) {
+        emit8(0x53); // push rbx
+#ifdef WINDOWS
+        emit8(0x48), emit8(0x83), emit8(0xEC), emit8(0x20); // sub rsp,32
+#endif
+        emit8(0x48), emit8(0xBB), emit64(uintptr_t(&cpu)); // mov rbx,cpu
+    }
+
+    // Decode instructions until the end of the page, a size limit, or something that changes CPU state
+    while (block.count < MAX_BLOCK) {
+        // Get the next opcode and the program counter value it would see in the pipeline
+        CachedOp op;
+        op.opcode = thumb ? U8TO16(host, block.size) : U8TO32(host, block.size);
+        op.cond = 0xE0;
+        uint32_t pc = address + block.size + (thumb ? 4 : 8);
+        block.size += (thumb ? 2 : 4);
+        block.count++;
+
+        // Choose the instruction handler and condition, and decide if the block should end after it
+        bool end;
+        if (thumb) {
+            // Look up a THUMB handler and end after branches or anything that changes CPU state
+            op.thumb = ArmInterp::thumbInstrs[(op.opcode >> 6) & 0x3FF];
+#if OP_STATS
+            op.stat = &cpu.thumbStats[(op.opcode >> 6) & 0x3FF];
+#endif
+            end = ((op.opcode & 0xF800) == 0xE000 || (op.opcode & 0xE800) == 0xE800 ||
+                (op.opcode & 0xFF00) == 0x4700 || (op.opcode & 0xFF00) == 0xBD00 || (op.opcode & 0xFE00) == 0xBE00 ||
+                (op.opcode & 0xFF00) == 0xDF00 || (op.opcode & 0xFFE0) == 0xB660);
+        }
+        else if ((op.opcode >> 28) == 0xF) {
+            // Handle reserved conditions separately and end, since they include CPS, SRS, and RFE
+            op.arm = &ArmInterp::handleReserved;
+#if OP_STATS
+            op.stat = &cpu.reservedStat;
+#endif
+            end = true;
+        }
+        else {
+            // Look up an ARM handler and end after branches, MSR, MCR, hints like WFI, or SWI
+            op.arm = ArmInterp::armInstrs[((op.opcode >> 16) & 0xFF0) | ((op.opcode >> 4) & 0xF)];
+#if OP_STATS
+            op.stat = &cpu.armStats[((op.opcode >> 16) & 0xFF0) | ((op.opcode >> 4) & 0xF)];
+#endif
+            op.cond = (op.opcode >> 24) & 0xF0;
+            end = ((op.opcode & 0xFE000000) == 0xEA000000 || (op.opcode & 0x0DB00000) == 0x01200000 ||
+                (op.opcode & 0x0F100010) == 0x0E000010 || (op.opcode & 0x0F000000) == 0x0F000000);
+        }
+
+        // Compile the instruction to host code, or store it pre-decoded
+        if (native) {
+            emitOp(op, pc, thumb, exits);
+        }
+        else {
+            memcpy(ptr, &op, sizeof(op));
+            ptr += sizeof(op);
+        }
+        if (end || !((address + block.size) & 0xFFF)) break;
+    }
+
+    // Finish compiled code by jumping to the next instruction when falling through, and point jumps to the exit
+    if (native) {
+        emitCall((void*)&ArmJit::exitBlock, address + block.size);
+        for (size_t i = 0; i < exits.size(); i++) {
+            uint32_t offset = ptr - (exits[i] + 4);
+            memcpy(exits[i], &offset, sizeof(offset));
+        }
+
+        // Restore the stack and RBX, then return
+#ifdef WINDOWS
+        emit8(0x48), emit8(0x83), emit8(0xC4), emit8(0x20); // add rsp,32
+#endif
+        emit8(0x5B); // pop rbx
+        emit8(0xC3); // ret
+    }
+
+    // Keep a copy of the code so the block can be revalidated after unrelated writes to its page
+    block.copy = ptr;
+    memcpy(ptr, host, block.size);
+    ptr += block.size;
+    if (native) setWritable(block.code, false);
+    return &block;
+}
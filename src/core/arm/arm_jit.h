@@ -0,0 +1,99 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../defines.h"
+#include "../op_stats.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ARM_JIT
+#endif
+
+class ArmInterp;
+class Core;
+
+enum NativeType {
+    NATIVE_NONE,
+    NATIVE_ALU,
+    NATIVE_TRANSFER
+};
+
+struct JitBlock {
+    uint32_t address;
+    uint8_t *host;
+    uint32_t *memTag;
+    uint32_t tag, size, count;
+    uint8_t *code, *copy;
+};
+
+struct CachedOp {
+    union {
+        int (ArmInterp::*arm)(uint32_t);
+        int (ArmInterp::*thumb)(uint16_t);
+    };
+    uint32_t opcode;
+    uint8_t cond;
+#if OP_STATS
+    OpStat *stat;
+#endif
+};
+
+class ArmJit {
+public:
+    ArmJit(Core &core, ArmInterp &cpu, bool native);
+    ~ArmJit();
+
+    bool runBlock();
+    void reset();
+
+private:
+    Core &core;
+    ArmInterp &cpu;
+    bool native, sharedTime;
+
+    uint8_t *buffer = nullptr;
+    uint8_t *ptr = nullptr;
+    std::unordered_map<uintptr_t, JitBlock> blocks;
+    JitBlock *cache[0x4000] = {};
+
+    JitBlock *compile(uint32_t address, uint8_t *host);
+    void runCached(JitBlock &block);
+    void setWritable(uint8_t *code, bool writable);
+
+    static int callArm(ArmInterp *cpu, uint32_t opcode);
+    static int callThumb(ArmInterp *cpu, uint32_t opcode);
+    static int callResolve(ArmInterp *cpu, uint32_t opcode);
+    static uint32_t loadWord(ArmInterp *cpu, uint32_t address);
+    static void storeWord(ArmInterp *cpu, uint32_t address, uint32_t value);
+    static void exitBlock(ArmInterp *cpu, uint32_t address);
+
+    void emit8(uint8_t value) { *ptr++ = value; }
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+    void emitDisp(uint8_t op, uint8_t reg, void *field);
+    void emitCall(void *func, uint32_t arg);
+    void emitCall(void *func);
+    void emitTransfer(bool load, uint8_t rd, int8_t rn, uint32_t offset);
+    uint8_t emitNative(CachedOp &op, uint32_t pc, bool thumb);
+    void emitOp(CachedOp &op, uint32_t pc, bool thumb, std::vector<uint8_t*> &exits);
+};
@@ -20,23 +20,147 @@
 #include <cstring>
 #include "../core.h"
 
-template uint8_t Cp15::read(CpuId, uint32_t);
-template uint16_t Cp15::read(CpuId, uint32_t);
-template uint32_t Cp15::read(CpuId, uint32_t);
-template void Cp15::write(CpuId, uint32_t, uint8_t);
-template void Cp15::write(CpuId, uint32_t, uint16_t);
-template void Cp15::write(CpuId, uint32_t, uint32_t);
+template uint8_t Cp15::readSlow(CpuId, uint32_t);
+template uint16_t Cp15::readSlow(CpuId, uint32_t);
+template uint32_t Cp15::readSlow(CpuId, uint32_t);
+template void Cp15::writeSlow(CpuId, uint32_t, uint8_t);
+template void Cp15::writeSlow(CpuId, uint32_t, uint16_t);
+template void Cp15::writeSlow(CpuId, uint32_t, uint32_t);
+
+MmuLeaf Cp15::emptyLeaf;
+
+Cp15::Cp15(Core &core): core(core) {
+    // Start each ARM11 core with the MMU cache for ASID 0
+    for (int i = 0; i < MAX_CPUS - 1; i++)
+        mmuCurrent[i] = getTable(CpuId(i), 0);
+
+    // Start each CPU with an empty fast map
+    for (int i = 0; i < MAX_CPUS; i++)
+        invalidateFast(CpuId(i));
+}
+
+Cp15::~Cp15() {
+    // Free the MMU caches and the leaves that were allocated for them
+    for (int i = 0; i < MAX_CPUS - 1; i++) {
+        for (int j = 0; j < 0x100; j++) {
+            if (!mmuTables[i][j]) continue;
+            for (int k = 0; k < 0x1000; k++)
+                if (mmuTables[i][j]->leaves[k] != &emptyLeaf) delete mmuTables[i][j]->leaves[k];
+            delete mmuTables[i][j];
+        }
+    }
+}
+
+FORCE_INLINE MmuMap &Cp15::getEntry(CpuId id, uint32_t address) {
+    // Look up a cached MMU mapping for the current ASID through its section's leaf, updating it if it's stale
+    // The empty leaf's tags are always zero, so it never matches and unused sections fall through to an update
+    MmuTable *table = mmuCurrent[id];
+    MmuMap &map = table->leaves[address >> 20]->maps[(address >> 12) & 0xFF];
+    return (map.tag == table->tag) ? map : updateEntry(id, address);
+}
+
+void Cp15::serialize(SaveState &s) {
+    // Transfer the coprocessor registers and TCM contents
+    s.io(exceptAddrs);
+    s.io(mmuEnables);
+    s.io(itcm);
+    s.io(dtcm);
+    s.io(dtcmRead);
+    s.io(dtcmWrite);
+    s.io(itcmRead);
+    s.io(itcmWrite);
+    s.io(dtcmAddr);
+    s.io(dtcmSize);
+    s.io(itcmSize);
+    s.io(ctrlRegs);
+    s.io(tlbBase0Regs);
+    s.io(tlbBase1Regs);
+    s.io(tlbCtrlRegs);
+    s.io(physAddrRegs);
+    s.io(contextIdRegs);
+    s.io(threadIdRegs);
+    s.io(dtcmReg);
+    s.io(itcmReg);
+
+    // Switch to the loaded ASIDs and drop cached MMU translations so they're rebuilt from the loaded tables
+    if (!s.loading) return;
+    for (int i = 0; i < MAX_CPUS - 1; i++) {
+        mmuCurrent[i] = getTable(CpuId(i), contextIdRegs[i] & 0xFF);
+        fastAsids[i] = uint64_t(contextIdRegs[i] & 0xFF) << 32;
+        mmuInvalidate(CpuId(i));
+    }
+    invalidateFast(ARM9);
+}
 
 uint8_t *Cp15::getReadPtr(CpuId id, uint32_t address) {
     // Get a readable memory pointer to use for caching
     if (id == ARM9) return tcmMap[address >> 12].read;
     if (!mmuEnables[id]) return core.memory.memMap11[address >> 12].read;
-    MmuMap &map = mmuMaps[id][address >> 12];
-    if (map.tag != mmuTags[id]) updateEntry(id, address);
-    return map.read;
+    return getEntry(id, address).read;
+}
+
+uint8_t *Cp15::getWritePtr(CpuId id, uint32_t address) {
+    // Get a writable memory pointer for block transfers and adjust its tag to signal change
+    uint8_t *data;
+    if (id == ARM9) {
+        TcmMap &map = tcmMap[address >> 12];
+        if ((data = map.write)) core.memory.updateTag(*map.memTag);
+    }
+    else if (!mmuEnables[id]) {
+        MemMap &map = core.memory.memMap11[address >> 12];
+        if ((data = map.write)) core.memory.updateTag(map.tag);
+    }
+    else {
+#if LOG_LEVEL > 3
+        // Send virtual writes through the regular path so special OS memory can still be logged
+        return nullptr;
+#endif
+        MmuMap &map = getEntry(id, address);
+        if ((data = map.write)) core.memory.updateTag(*map.memTag);
+    }
+    return data;
 }
 
-uint32_t Cp15::mmuTranslate(CpuId id, uint32_t address) {
+uint32_t *Cp15::getMemTag(CpuId id, uint32_t address) {
+    // Get the tag of the physical memory page behind an address, watching the page for writes that change it
+    if (id == ARM9 || !mmuEnables[id]) {
+        core.memory.watchPage(address);
+        return (id == ARM9) ? tcmMap[address >> 12].memTag : &core.memory.memMap11[address >> 12].tag;
+    }
+    MmuMap &map = getEntry(id, address);
+    core.memory.watchPage(map.addr);
+    return map.memTag;
+}
+
+uint32_t Cp15::getProcess(CpuId id) {
+    // Get the active 3DS kernel process struct from its fixed location once the MMU is set up
+    if (id == ARM9 || !mmuEnables[id]) return 0;
+    uint8_t *data = getReadPtr(id, 0xFFFF9004);
+    return data ? U8TO32(data, 0x004) : 0;
+}
+
+bool Cp15::getProcName(CpuId id, uint32_t process, char *name) {
+    // Detect name location, which differs based on console type and version
+    // Only direct memory is read, so this never has side effects or logs unmapped accesses
+    uint8_t *data = getReadPtr(id, process + (core.n3dsMode ? 0xB8 : 0xB0));
+    if (!data) return false;
+    uint32_t kCodeSet = U8TO32(data, (process + (core.n3dsMode ? 0xB8 : 0xB0)) & 0xFFF);
+    if (!(data = getReadPtr(id, kCodeSet + 0x50))) return false;
+    if (data[(kCodeSet + 0x50) & 0xFFF] - 0x20 > 0x5FU) { // Pre-8.0.0
+        if (!(data = getReadPtr(id, process + 0xA8))) return false;
+        kCodeSet = U8TO32(data, (process + 0xA8) & 0xFFF);
+        if (!(data = getReadPtr(id, kCodeSet + 0x50))) return false;
+    }
+
+    // Copy the name, which is up to 8 characters, unless it crosses into another page
+    if (((kCodeSet + 0x50) & 0xFFF) > 0xFF8) return false;
+    for (int i = 0; i < 8; i++)
+        name[i] = data[(kCodeSet + 0x50 + i) & 0xFFF];
+    name[8] = '\0';
+    return true;
+}
+
+uint32_t Cp15::mmuTranslate(CpuId id, uint32_t address, uint32_t *span) {
     // Check control value X to determine the table base address
     uint32_t base;
     if (tlbCtrlRegs[id]) {
@@ -49,21 +173,26 @@ uint32_t Cp15::mmuTranslate(CpuId id, uint32_t address) {
         base = (tlbBase0Regs[id] & 0xFFFFC000);
     }
 
-    // Translate a virtual address to physical using MMU translation tables
+    // Translate a virtual address to physical using MMU translation tables, reporting the size of the mapping used
     // TODO: handle all the extra bits
+    uint32_t dummy;
+    if (!span) span = &dummy;
     uint32_t entry = core.memory.read<uint32_t>(id, base + ((address >> 18) & 0x3FFC));
     switch (entry & 0x3) {
     case 0x1: // Coarse
         entry = core.memory.read<uint32_t>(id, (entry & 0xFFFFFC00) + ((address >> 10) & 0x3FC));
         switch (entry & 0x3) {
         case 0x1: // 64KB large page
+            *span = 0x10000;
             return (entry & 0xFFFF0000) | (address & 0xFFFF);
         case 0x2: case 0x3: // 4KB small page
+            *span = 0x1000;
             return (entry & 0xFFFFF000) | (address & 0xFFF);
         }
         break;
 
     case 0x2: // Section
+        *span = (entry & BIT(18)) ? 0x1000000 : 0x100000;
         if (entry & BIT(18)) // 16MB supersection
             return (entry & 0xFF000000) | (address & 0xFFFFFF);
         else // 1MB section
@@ -72,37 +201,127 @@ uint32_t Cp15::mmuTranslate(CpuId id, uint32_t address) {
 
     // Catch unhandled translation table entries
     LOG_CRIT("Unhandled ARM11 core %d MMU translation fault at 0x%X\n", id, address);
+    *span = 0x1000;
     return address;
 }
 
+MmuTable *Cp15::getTable(CpuId id, uint8_t asid) {
+    // Get the MMU cache for an ASID, creating it with every section pointing at the shared empty leaf if new
+    MmuTable *&table = mmuTables[id][asid];
+    if (table) return table;
+    table = new MmuTable();
+    table->tag = 1;
+    for (int i = 0; i < 0x1000; i++)
+        table->leaves[i] = &emptyLeaf;
+    return table;
+}
+
+void Cp15::invalidateTable(MmuTable *table) {
+    // Increment an MMU cache's tag to invalidate its maps and reset its leaves on overflow to avoid false positives
+    if (++table->tag) return;
+    for (int i = 0; i < 0x1000; i++)
+        if (table->leaves[i] != &emptyLeaf) memset(table->leaves[i], 0, sizeof(MmuLeaf));
+    table->tag = 1;
+}
+
 void Cp15::mmuInvalidate(CpuId id) {
-    // Increment the MMU tag to invalidate maps and reset on overflow to avoid false positives
+    // Invalidate cached MMU translations for all ASIDs
     core.arms[id].invalidatePc();
-    if (++mmuTags[id]) return;
-    memset(mmuMaps[id], 0, sizeof(mmuMaps[id]));
-    mmuTags[id] = 1;
+    invalidateFast(id);
+    for (int i = 0; i < 0x100; i++)
+        if (mmuTables[id][i]) invalidateTable(mmuTables[id][i]);
+}
+
+void Cp15::mmuInvalidateAsid(CpuId id, uint8_t asid) {
+    // Invalidate cached MMU translations for one ASID, including its copies of global ones
+    // Fast mappings from other ASIDs are kept across switches, so they're dropped even if the ASID isn't current
+    core.arms[id].invalidatePc();
+    invalidateFast(id);
+    if (mmuTables[id][asid]) invalidateTable(mmuTables[id][asid]);
+}
+
+void Cp15::mmuInvalidateMva(CpuId id, uint32_t address) {
+    // Drop cached MMU translations for a virtual address in every ASID, since global ones are copied between them
+    // Entries from larger pages and sections stand for more than their own 4KB, so their whole block is dropped
+    core.arms[id].invalidatePc();
+    invalidateFast(id);
+    uint32_t section = (address >> 20);
+    for (int i = 0; i < 0x100; i++) {
+        if (!mmuTables[id][i]) continue;
+        for (uint32_t j = (section & ~0xF); j <= (section | 0xF); j++) {
+            MmuLeaf *leaf = mmuTables[id][i]->leaves[j];
+            if (leaf == &emptyLeaf) continue;
+            if (leaf->span >= 0x1000000 || (leaf->span == 0x100000 && j == section)) {
+                for (int k = 0; k < 0x100; k++)
+                    leaf->maps[k].tag = 0;
+                leaf->span = 0;
+            }
+            else if (j == section) {
+                uint32_t count = (leaf->span == 0x10000) ? 0x10 : 0x1;
+                uint32_t page = (address >> 12) & 0xFF & ~(count - 1);
+                for (uint32_t k = page; k < page + count; k++)
+                    leaf->maps[k].tag = 0;
+            }
+        }
+    }
 }
 
-void Cp15::updateEntry(CpuId id, uint32_t address) {
-    // Cache an MMU read/write mapping with the current tag
-    MmuMap &map = mmuMaps[id][address >> 12];
-    address = mmuTranslate(id, address);
+MmuMap &Cp15::updateEntry(CpuId id, uint32_t address) {
+    // Allocate a leaf for the address's 1MB section in the current ASID's cache if it's still using the empty one
+    // Threaded ARM11 cores can be looked up from elsewhere, so only one new leaf is kept if they race
+    MmuTable *table = mmuCurrent[id];
+    MmuLeaf *&leaf = table->leaves[address >> 20];
+    if (leaf == &emptyLeaf) {
+        MmuLeaf *expected = &emptyLeaf, *alloc = new MmuLeaf();
+        if (!__atomic_compare_exchange_n(&leaf, &expected, alloc, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            delete alloc;
+    }
+
+    // Cache an MMU read/write mapping with the current tag, noting the largest mapping size the leaf holds
+    MmuMap &map = leaf->maps[(address >> 12) & 0xFF];
+    uint32_t span;
+    address = mmuTranslate(id, address, &span);
+    leaf->span = std::max(leaf->span, span);
     map.read = core.memory.memMap11[address >> 12].read;
     map.write = core.memory.memMap11[address >> 12].write;
     map.memTag = &core.memory.memMap11[address >> 12].tag;
     map.addr = (address & ~0xFFF);
-    map.tag = mmuTags[id];
+    map.tag = table->tag;
+    return map;
+}
+
+void Cp15::invalidateFast(CpuId id) {
+    // Drop all of a CPU's fast mappings by giving them an unaligned address that lookups never match
+    for (int i = 0; i < 0x400; i++) {
+        __atomic_store_n(&fastMaps[id][i].readAddr, 0xFFF, __ATOMIC_RELAXED);
+        __atomic_store_n(&fastMaps[id][i].writeAddr, 0xFFF, __ATOMIC_RELAXED);
+    }
+}
+
+void Cp15::dropFastWrites(uint32_t address) {
+    // Drop fast write mappings to a physical page from every CPU so its next write goes through the slow path
+    // Only pages that were cached since they were last dropped have to be searched for
+    uint32_t bit = BIT((address >> 12) & 0x1F);
+    if (!(__atomic_fetch_and(&fastWrites[address >> 17], ~bit, __ATOMIC_SEQ_CST) & bit)) return;
+    address &= ~0xFFF;
+
+    // Search every CPU's map, accessing entries atomically since their owners keep using them meanwhile
+    for (int i = 0; i < MAX_CPUS; i++)
+        for (int j = 0; j < 0x400; j++)
+            if (__atomic_load_n(&fastPhys[i][j], __ATOMIC_RELAXED) == address)
+                __atomic_store_n(&fastMaps[i][j].writeAddr, 0xFFF, __ATOMIC_RELAXED);
 }
 
 void Cp15::updateMap9(uint32_t start, uint32_t end) {
     // Rebuild part of the ARM9 TCM memory map
     core.arms[ARM9].invalidatePc();
+    invalidateFast(ARM9);
     for (uint64_t address = start; address <= end; address += 0x1000) {
         // Use the ARM9 physical memory map as a base
         TcmMap &map = tcmMap[address >> 12];
         map.read = core.memory.memMap9[address >> 12].read;
         map.write = core.memory.memMap9[address >> 12].write;
-        map.memTag = &core.memory.memMap9[address >> 12].tag;
+        map.memTag = &core.memory.memMap11[address >> 12].tag;
 
         // Overlay TCM read/write mappings if enabled
         if (address < itcmSize) {
@@ -116,7 +335,7 @@ void Cp15::updateMap9(uint32_t start, uint32_t end) {
     }
 }
 
-template <typename T> T Cp15::read(CpuId id, uint32_t address) {
+template <typename T> T Cp15::readSlow(CpuId id, uint32_t address) {
     // Get a pointer to mapped readable memory if it exists
     uint8_t *data;
     if (id == ARM9) {
@@ -126,8 +345,7 @@ template <typename T> T Cp15::read(CpuId id, uint32_t address) {
     }
     else if (mmuEnables[id]) {
         // Read from ARM11 virtual memory, updating the cache if necessary
-        MmuMap &map = mmuMaps[id][address >> 12];
-        if (map.tag != mmuTags[id]) updateEntry(id, address);
+        MmuMap &map = getEntry(id, address);
         if (!(data = map.read)) address = map.addr | (address & 0xFFF);
     }
     else {
@@ -139,6 +357,11 @@ template <typename T> T Cp15::read(CpuId id, uint32_t address) {
     if (!data)
         return core.memory.readFallback<T>(id, address);
 
+    // Cache the page in the fast map so later reads from it skip the lookup
+    FastMap &fast = fastMaps[id][(address >> 12) & 0x3FF];
+    fast.read = uintptr_t(data) - (address & ~0xFFF);
+    __atomic_store_n(&fast.readAddr, fastAsids[id] | (address & ~0xFFF), __ATOMIC_RELAXED);
+
     // Load an LSB-first value from a direct memory pointer
     T value = 0;
     data += (address & 0xFFF);
@@ -147,36 +370,31 @@ template <typename T> T Cp15::read(CpuId id, uint32_t address) {
     return value;
 }
 
-template <typename T> void Cp15::write(CpuId id, uint32_t address, T value) {
-    // Get a pointer to mapped writable memory and adjust its tag to signal change
+template <typename T> void Cp15::writeSlow(CpuId id, uint32_t address, T value) {
+    // Get a pointer to mapped writable memory along with the tag and address of its physical page
     uint8_t *data;
+    uint32_t *memTag, phys = (address & ~0xFFF);
     if (id == ARM9) {
         // Align the address and write to ARM9 memory with TCM
         address &= ~(sizeof(T) - 1);
         TcmMap &map = tcmMap[address >> 12];
         data = map.write;
-        (*map.memTag)++;
+        memTag = map.memTag;
     }
     else if (mmuEnables[id]) {
         // Write to ARM11 virtual memory, updating the cache if necessary
-        MmuMap &map = mmuMaps[id][address >> 12];
-        if (map.tag != mmuTags[id]) updateEntry(id, address);
+        MmuMap &map = getEntry(id, address);
         if (!(data = map.write)) address = map.addr | (address & 0xFFF);
-        (*map.memTag)++;
+        memTag = map.memTag;
+        phys = map.addr;
 
 #if LOG_LEVEL > 3
         // Catch writes to special memory used by the 3DS OS
         if (address == 0xFFFF9004 && value) {
-            // Detect name location, which differs based on console type and version
-            uint32_t kCodeSet = read<uint32_t>(id, value + (core.n3dsMode ? 0xB8 : 0xB0));
-            if (read<uint8_t>(id, kCodeSet + 0x50) - 0x20 > 0x5FU)
-                kCodeSet = read<uint32_t>(id, value + 0xA8); // Pre-8.0.0
-
             // Log process names when the active 3DS kernel process struct changes
-            uint8_t procName[9] = {};
-            for (int i = 0; i < 8; i++)
-                procName[i] = read<uint8_t>(id, kCodeSet + 0x50 + i);
-            LOG_OS("ARM11 core %d kernel switching to process '%s'\n", id, procName);
+            char procName[9];
+            if (getProcName(id, value, procName))
+                LOG_OS("ARM11 core %d kernel switching to process '%s'\n", id, procName);
         }
         else if (address >= threadIdRegs[id][1] + 0x80 && address < threadIdRegs[id][1] + 0x180) {
             // Log IPC commands when the TLS buffer is written to
@@ -188,17 +406,40 @@ template <typename T> void Cp15::write(CpuId id, uint32_t address, T value) {
         // Write to ARM11 physical memory
         MemMap &map = core.memory.memMap11[address >> 12];
         data = map.write;
-        map.tag++;
+        memTag = &map.tag;
     }
 
-    // Fall back to write handlers for special cases
-    if (!data)
+    // Fall back to write handlers for special cases, adjusting the tag to signal change
+    if (!data) {
+        core.memory.updateTag(*memTag);
         return core.memory.writeFallback<T>(id, address, value);
+    }
 
-    // Write an LSB-first value to a direct memory pointer
+    // Write an LSB-first value to a direct memory pointer and adjust its tag to signal change
+    // The page's watch is cleared first, so a new one set during the write still gets noticed below
+    bool watched = core.memory.unwatchPage(phys);
+    uint8_t *page = data;
     data += (address & 0xFFF);
     for (uint32_t i = 0; i < sizeof(T); i++)
         data[i] = value >> (i << 3);
+    core.memory.updateTag(*memTag);
+
+    // Leave pages that were just watched uncached, since they're likely to be watched again soon
+    if (watched) return;
+
+#if LOG_LEVEL > 3
+    // Keep virtual writes on the slow path so special OS memory can still be logged
+    if (id != ARM9 && mmuEnables[id]) return;
+#endif
+
+    // Cache the page in the fast map so later writes to it skip the lookup and tag, unless it was watched again
+    // The page is marked first so a racing watch either searches for the mapping or gets seen here
+    __atomic_fetch_or(&fastWrites[phys >> 17], BIT((phys >> 12) & 0x1F), __ATOMIC_SEQ_CST);
+    FastMap &fast = fastMaps[id][(address >> 12) & 0x3FF];
+    fast.write = uintptr_t(page) - (address & ~0xFFF);
+    __atomic_store_n(&fastPhys[id][(address >> 12) & 0x3FF], phys, __ATOMIC_RELAXED);
+    __atomic_store_n(&fast.writeAddr, fastAsids[id] | (address & ~0xFFF), __ATOMIC_RELAXED);
+    if (core.memory.isWatched(phys)) __atomic_store_n(&fast.writeAddr, 0xFFF, __ATOMIC_RELAXED);
 }
 
 uint32_t Cp15::readReg(CpuId id, uint8_t cn, uint8_t cm, uint8_t cp) {
@@ -211,6 +452,7 @@ uint32_t Cp15::readReg(CpuId id, uint8_t cn, uint8_t cm, uint8_t cp) {
             case 0x020001: return tlbBase1Regs[id]; // TLB base 1
             case 0x020002: return tlbCtrlRegs[id]; // TLB control
             case 0x070400: return physAddrRegs[id]; // Physical address
+            case 0x0D0001: return contextIdRegs[id]; // Context ID
             case 0x0D0002: return threadIdRegs[id][0]; // Thread ID 0
             case 0x0D0003: return threadIdRegs[id][1]; // Thread ID 1
             case 0x0D0004: return threadIdRegs[id][2]; // Thread ID 2
@@ -253,18 +495,19 @@ void Cp15::writeReg(CpuId id, uint8_t cn, uint8_t cm, uint8_t cp, uint32_t value
             case 0x070A04: return; // Data sync barrier (stub)
             case 0x070A05: return; // Data memory barrier (stub)
             case 0x070E01: return; // Clean+invalidate d-cache line (stub)
-            case 0x080500: return mmuInvalidate(id); // Invalidate i-TLB (stub)
-            case 0x080501: return mmuInvalidate(id); // Invalidate i-TLB by MVA+ASID (stub)
-            case 0x080502: return mmuInvalidate(id); // Invalidate i-TLB by ASID (stub)
-            case 0x080503: return mmuInvalidate(id); // Invalidate i-TLB by MVA (stub)
-            case 0x080600: return mmuInvalidate(id); // Invalidate d-TLB (stub)
-            case 0x080601: return mmuInvalidate(id); // Invalidate d-TLB by MVA+ASID (stub)
-            case 0x080602: return mmuInvalidate(id); // Invalidate d-TLB by ASID (stub)
-            case 0x080603: return mmuInvalidate(id); // Invalidate d-TLB by MVA (stub)
-            case 0x080700: return mmuInvalidate(id); // Invalidate TLB (stub)
-            case 0x080701: return mmuInvalidate(id); // Invalidate TLB by MVA+ASID (stub)
-            case 0x080702: return mmuInvalidate(id); // Invalidate TLB by ASID (stub)
-            case 0x080703: return mmuInvalidate(id); // Invalidate TLB by MVA (stub)
+            case 0x080500: return mmuInvalidate(id); // Invalidate i-TLB
+            case 0x080501: return mmuInvalidateMva(id, value); // Invalidate i-TLB by MVA+ASID
+            case 0x080502: return mmuInvalidateAsid(id, value); // Invalidate i-TLB by ASID
+            case 0x080503: return mmuInvalidateMva(id, value); // Invalidate i-TLB by MVA
+            case 0x080600: return mmuInvalidate(id); // Invalidate d-TLB
+            case 0x080601: return mmuInvalidateMva(id, value); // Invalidate d-TLB by MVA+ASID
+            case 0x080602: return mmuInvalidateAsid(id, value); // Invalidate d-TLB by ASID
+            case 0x080603: return mmuInvalidateMva(id, value); // Invalidate d-TLB by MVA
+            case 0x080700: return mmuInvalidate(id); // Invalidate TLB
+            case 0x080701: return mmuInvalidateMva(id, value); // Invalidate TLB by MVA+ASID
+            case 0x080702: return mmuInvalidateAsid(id, value); // Invalidate TLB by ASID
+            case 0x080703: return mmuInvalidateMva(id, value); // Invalidate TLB by MVA
+            case 0x0D0001: return writeContextId(id, value); // Context ID
             case 0x0D0002: return writeThreadId(id, 0, value); // Thread ID 0
             case 0x0D0003: return writeThreadId(id, 1, value); // Thread ID 1
             case 0x0D0004: return writeThreadId(id, 2, value); // Thread ID 2
@@ -295,8 +538,12 @@ void Cp15::writeReg(CpuId id, uint8_t cn, uint8_t cm, uint8_t cp, uint32_t value
 void Cp15::writeCtrl11(CpuId id, uint32_t value) {
     // Set writable control bits on the ARM11
     ctrlRegs[id] = (ctrlRegs[id] & ~0x32C0BB07) | (value & 0x32C0BB07);
-    mmuEnables[id] = (ctrlRegs[id] & BIT(0));
     exceptAddrs[id] = (ctrlRegs[id] & BIT(13)) ? 0xFFFF0000 : 0x00000000;
+
+    // Drop fast mappings when switching between physical and virtual addressing
+    if (mmuEnables[id] == bool(ctrlRegs[id] & BIT(0))) return;
+    mmuEnables[id] = (ctrlRegs[id] & BIT(0));
+    invalidateFast(id);
 }
 
 void Cp15::writeCtrl9(CpuId id, uint32_t value) {
@@ -317,7 +564,9 @@ void Cp15::writeTlbBase0(CpuId id, uint32_t value) {
     // Set a core's translation table base 0 register
     tlbBase0Regs[id] = value;
     LOG_INFO("Changing ARM11 core %d translation table base 0 to 0x%X\n", id, tlbBase0Regs[id] & 0xFFFFFF80);
-    mmuInvalidate(id);
+
+    // Keep cached translations, which are separated by ASID and explicitly invalidated by the OS like on hardware
+    core.arms[id].invalidatePc();
 }
 
 void Cp15::writeTlbBase1(CpuId id, uint32_t value) {
@@ -340,6 +589,17 @@ void Cp15::writeAddrTrans(CpuId id, uint32_t value) {
     physAddrRegs[id] = mmuTranslate(id, value);
 }
 
+void Cp15::writeContextId(CpuId id, uint32_t value) {
+    // Set a core's context ID and switch to the MMU cache for its ASID
+    // Fast mappings are tagged with the ASID, so the new one misses the old ones without flushing them
+    contextIdRegs[id] = value;
+    MmuTable *table = getTable(id, value & 0xFF);
+    if (mmuCurrent[id] == table) return;
+    mmuCurrent[id] = table;
+    fastAsids[id] = uint64_t(value & 0xFF) << 32;
+    core.arms[id].invalidatePc();
+}
+
 void Cp15::writeThreadId(CpuId id, int i, uint32_t value) {
     // Set one of a core's thread ID registers
     // TODO: enforce access permissions
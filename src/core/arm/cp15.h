@@ -23,6 +23,7 @@
 #include "../defines.h"
 
 class Core;
+class SaveState;
 
 struct MmuMap {
     uint8_t *read, *write;
@@ -30,20 +31,44 @@ struct MmuMap {
     uint32_t addr, tag;
 };
 
+struct MmuLeaf {
+    MmuMap maps[0x100];
+    uint32_t span;
+};
+
+struct MmuTable {
+    uint32_t tag;
+    MmuLeaf *leaves[0x1000];
+};
+
 struct TcmMap {
     uint8_t *read, *write;
     uint32_t *memTag;
 };
 
+struct FastMap {
+    uintptr_t read, write;
+    uint64_t readAddr, writeAddr;
+};
+
 class Cp15 {
 public:
     uint32_t exceptAddrs[MAX_CPUS] = {};
 
-    Cp15(Core &core): core(core) {}
+    Cp15(Core &core);
+    ~Cp15();
+    void serialize(SaveState &s);
     uint8_t *getReadPtr(CpuId id, uint32_t address);
+    uint8_t *getWritePtr(CpuId id, uint32_t address);
+    uint32_t *getMemTag(CpuId id, uint32_t address);
+    uint32_t getProcess(CpuId id);
+    bool getProcName(CpuId id, uint32_t process, char *name);
 
     void mmuInvalidate(CpuId id);
+    void mmuInvalidateAsid(CpuId id, uint8_t asid);
+    void mmuInvalidateMva(CpuId id, uint32_t address);
     void updateMap9(uint32_t start, uint32_t end);
+    void dropFastWrites(uint32_t address);
 
     template <typename T> T read(CpuId id, uint32_t address);
     template <typename T> void write(CpuId id, uint32_t address, T value);
@@ -54,10 +79,16 @@ public:
 private:
     Core &core;
 
-    MmuMap mmuMaps[MAX_CPUS - 1][0x100000] = {};
+    FastMap fastMaps[MAX_CPUS][0x400];
+    uint32_t fastPhys[MAX_CPUS][0x400] = {};
+    uint64_t fastAsids[MAX_CPUS] = {};
+    uint32_t fastWrites[0x100000 >> 5] = {};
+
+    static MmuLeaf emptyLeaf;
+    MmuTable *mmuTables[MAX_CPUS - 1][0x100] = {};
+    MmuTable *mmuCurrent[MAX_CPUS - 1] = {};
     TcmMap tcmMap[0x100000] = {};
 
-    uint32_t mmuTags[MAX_CPUS - 1] = { 1, 1, 1, 1 };
     bool mmuEnables[MAX_CPUS - 1] = {};
     uint8_t itcm[0x8000] = {};
     uint8_t dtcm[0x4000] = {};
@@ -72,12 +103,20 @@ private:
     uint32_t tlbBase1Regs[MAX_CPUS - 1] = {};
     uint32_t tlbCtrlRegs[MAX_CPUS - 1] = {};
     uint32_t physAddrRegs[MAX_CPUS - 1] = {};
+    uint32_t contextIdRegs[MAX_CPUS - 1] = {};
     uint32_t threadIdRegs[MAX_CPUS - 1][3] = {};
     uint32_t dtcmReg = 0;
     uint32_t itcmReg = 0;
 
-    uint32_t mmuTranslate(CpuId id, uint32_t address);
-    void updateEntry(CpuId id, uint32_t address);
+    uint32_t mmuTranslate(CpuId id, uint32_t address, uint32_t *span = nullptr);
+    MmuTable *getTable(CpuId id, uint8_t asid);
+    void invalidateTable(MmuTable *table);
+    MmuMap &getEntry(CpuId id, uint32_t address);
+    MmuMap &updateEntry(CpuId id, uint32_t address);
+    void invalidateFast(CpuId id);
+
+    template <typename T> T readSlow(CpuId id, uint32_t address);
+    template <typename T> void writeSlow(CpuId id, uint32_t address, T value);
 
     void writeCtrl11(CpuId id, uint32_t value);
     void writeCtrl9(CpuId id, uint32_t value);
@@ -85,8 +124,38 @@ private:
     void writeTlbBase1(CpuId id, uint32_t value);
     void writeTlbCtrl(CpuId id, uint32_t value);
     void writeAddrTrans(CpuId id, uint32_t value);
+    void writeContextId(CpuId id, uint32_t value);
     void writeThreadId(CpuId id, int i, uint32_t value);
     void writeWfi(CpuId id, uint32_t value);
     void writeDtcm(CpuId id, uint32_t value);
     void writeItcm(CpuId id, uint32_t value);
 };
+
+template <typename T> FORCE_INLINE T Cp15::read(CpuId id, uint32_t address) {
+    // Look up the page in the CPU's fast map, where unaligned addresses or other ASIDs miss and take the slow path
+    FastMap &map = fastMaps[id][(address >> 12) & 0x3FF];
+    uint64_t key = fastAsids[id] | (address & uint32_t(~0xFFF | (sizeof(T) - 1)));
+    if (__atomic_load_n(&map.readAddr, __ATOMIC_RELAXED) != key)
+        return readSlow<T>(id, address);
+
+    // Load an LSB-first value from the host page
+    T value = 0;
+    uint8_t *data = (uint8_t*)(map.read + address);
+    for (uint32_t i = 0; i < sizeof(T); i++)
+        value |= data[i] << (i << 3);
+    return value;
+}
+
+template <typename T> FORCE_INLINE void Cp15::write(CpuId id, uint32_t address, T value) {
+    // Look up the page in the CPU's fast map, where unaligned addresses or other ASIDs miss and take the slow path
+    // Other threads can drop the mapping at any time, so the address is loaded atomically
+    FastMap &map = fastMaps[id][(address >> 12) & 0x3FF];
+    uint64_t key = fastAsids[id] | (address & uint32_t(~0xFFF | (sizeof(T) - 1)));
+    if (__atomic_load_n(&map.writeAddr, __ATOMIC_RELAXED) != key)
+        return writeSlow<T>(id, address, value);
+
+    // Store an LSB-first value to the host page
+    uint8_t *data = (uint8_t*)(map.write + address);
+    for (uint32_t i = 0; i < sizeof(T); i++)
+        data[i] = value >> (i << 3);
+}
@@ -21,6 +21,24 @@
 
 #define IRQ_NONE 0x3FF
 
+void Interrupts::serialize(SaveState &s) {
+    // Transfer the interrupt controller registers
+    s.io(cfg11MpBootcnt);
+    s.io(sources);
+    s.io(cfg11MpClkcnt);
+    s.io(mpIle);
+    s.io(mpPrioMask);
+    s.io(mpIge);
+    s.io(mpIe);
+    s.io(mpIp);
+    s.io(mpIa);
+    s.io(mpPriorityL);
+    s.io(mpPriorityG);
+    s.io(mpTarget);
+    s.io(irqIe);
+    s.io(irqIf);
+}
+
 void Interrupts::sendInterrupt(CpuId id, int type) {
     // Send an interrupt to the ARM9
     if (id == ARM9) {
@@ -29,9 +47,8 @@ void Interrupts::sendInterrupt(CpuId id, int type) {
             irqIf |= BIT(type);
 
         // Schedule an interrupt if any requested interrupts are enabled
-        if (scheduled[ARM9] || !(irqIe & irqIf)) return;
-        core.schedule(ARM9_INTERRUPT, 2);
-        scheduled[ARM9] = true;
+        if (irqIe & irqIf)
+            core.scheduleOnce(ARM9_INTERRUPT, 2);
         return;
     }
 
@@ -44,15 +61,13 @@ void Interrupts::sendInterrupt(CpuId id, int type) {
             mpIp[i][type >> 5] |= BIT(type & 0x1F);
 
         // Schedule an interrupt if any pending interrupts are enabled
-        if (scheduled[i] || readMpPending(CpuId(i)) == IRQ_NONE) continue;
-        core.schedule(Task(ARM11A_INTERRUPT + i), 1);
-        scheduled[i] = true;
+        if (readMpPending(CpuId(i)) == IRQ_NONE) continue;
+        core.scheduleOnce(Task(ARM11A_INTERRUPT + i), 1);
     }
 }
 
 void Interrupts::interrupt(CpuId id) {
     // Set the unhalted bit for extra ARM11 cores if started, or ignore the interrupt
-    scheduled[id] = false;
     if (id == ARM11C || id == ARM11D) {
         if (cfg11MpBootcnt[id - 2] & BIT(4))
             cfg11MpBootcnt[id - 2] |= BIT(5);
@@ -67,6 +82,7 @@ void Interrupts::interrupt(CpuId id) {
 
 void Interrupts::halt(CpuId id, uint8_t type) {
     // Halt a CPU and check if all ARM11 cores have been halted
+    CoreLock lock(core);
     core.arms[id].halt(BIT(type));
     if (id != ARM9 && core.arms[ARM11A].halted && core.arms[ARM11B].halted &&
             core.arms[ARM11C].halted && core.arms[ARM11D].halted) {
@@ -22,12 +22,14 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class Interrupts {
 public:
     uint8_t cfg11MpBootcnt[2] = {};
 
     Interrupts(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     void sendInterrupt(CpuId id, int type);
     void checkInterrupt(CpuId id) { sendInterrupt(id, -1); }
@@ -73,7 +75,6 @@ public:
 private:
     Core &core;
 
-    bool scheduled[MAX_CPUS] = {};
     uint8_t sources[MAX_CPUS - 1][0x10] = {};
 
     uint32_t cfg11MpClkcnt = 0;
@@ -19,6 +19,22 @@
 
 #include "../core.h"
 
+void Timers::serialize(SaveState &s) {
+    // Transfer the timer registers and their scheduled end points
+    s.io(mpScale);
+    s.io(endCyclesMp);
+    s.io(endCyclesTm);
+    s.io(timers);
+    s.io(shifts);
+    s.io(countUp);
+    s.io(mpReload);
+    s.io(mpCounter);
+    s.io(mpTmcnt);
+    s.io(mpTmirq);
+    s.io(tmCntL);
+    s.io(tmCntH);
+}
+
 void Timers::resetCycles() {
     // Adjust timer end cycles for a global cycle reset
     for (CpuId id = ARM11A; id < ARM9; id = CpuId(id + 1))
@@ -42,18 +58,18 @@ void Timers::setMpScale(int scale) {
 }
 
 void Timers::scheduleMp(CpuId id, int i) {
+    // Unschedule the timer if it's stopped
+    Task task = Task(TMR11A_UNDERFLOW0 + id * 2 + i);
+    if (~mpTmcnt[id][i] & BIT(0))
+        return core.cancel(task);
+
     // Schedule a timer underflow using its prescaler, with half the ARM11 frequency as a base
-    if (~mpTmcnt[id][i] & BIT(0)) return;
     uint64_t cycles = (uint64_t(mpCounter[id][i]) + 1) * (((mpTmcnt[id][i]) >> 8) + 1) * 2 / mpScale;
-    core.schedule(Task(TMR11A_UNDERFLOW0 + id * 2 + i), cycles);
+    core.reschedule(task, cycles);
     endCyclesMp[id][i] = core.globalCycles + cycles;
 }
 
 void Timers::underflowMp(CpuId id, int i) {
-    // Ensure underflow should still occur at the current timestamp
-    if (!(mpTmcnt[id][i] & BIT(0)) || endCyclesMp[id][i] != core.globalCycles)
-        return;
-
     // Reload the timer or stop at zero
     if (mpTmcnt[id][i] & BIT(1)) {
         mpCounter[id][i] = mpReload[id][i];
@@ -71,8 +87,8 @@ void Timers::underflowMp(CpuId id, int i) {
 }
 
 void Timers::overflowTm(int i) {
-    // Ensure overflow should still occur at the current timestamp
-    if (!(tmCntH[i] & BIT(7)) || (!countUp[i] && endCyclesTm[i] != core.globalCycles))
+    // Ensure the timer is still running, since count-up overflows are triggered directly
+    if (~tmCntH[i] & BIT(7))
         return;
 
     // Reload the timer and trigger an overflow interrupt if enabled
@@ -83,7 +99,7 @@ void Timers::overflowTm(int i) {
     // Schedule the next timer overflow if not in count-up mode
     if (!countUp[i]) {
         uint64_t cycles = (0x10000 - timers[i]) << shifts[i];
-        core.schedule(Task(TMR9_OVERFLOW0 + i), cycles);
+        core.reschedule(Task(TMR9_OVERFLOW0 + i), cycles);
         endCyclesTm[i] = core.globalCycles + cycles;
     }
 
@@ -185,10 +201,14 @@ void Timers::writeTmCntH(int i, uint16_t mask, uint16_t value) {
         dirty = true;
     }
 
-    // Schedule a timer overflow if the timer changed and isn't in count-up mode
-    if (dirty && (tmCntH[i] & BIT(7)) && !countUp[i]) {
+    // Unschedule the timer if it's stopped or in count-up mode
+    if (!(tmCntH[i] & BIT(7)) || countUp[i])
+        return core.cancel(Task(TMR9_OVERFLOW0 + i));
+
+    // Reschedule the timer overflow if the timer changed
+    if (dirty) {
         uint64_t cycles = (0x10000 - timers[i]) << shifts[i];
-        core.schedule(Task(TMR9_OVERFLOW0 + i), cycles);
+        core.reschedule(Task(TMR9_OVERFLOW0 + i), cycles);
         endCyclesTm[i] = core.globalCycles + cycles;
     }
 }
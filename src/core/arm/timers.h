@@ -22,10 +22,12 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class Timers {
 public:
     Timers(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     void resetCycles();
     void setMpScale(int scale);
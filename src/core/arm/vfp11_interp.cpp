@@ -18,8 +18,60 @@
 */
 
 #include <cmath>
+#include <cstring>
 #include "../core.h"
 
+// VFP10 single data operation lookup table, using bits p, q, r, and s of an opcode
+void (Vfp11Interp::*Vfp11Interp::dataInstrsS[])(uint8_t, uint8_t, uint8_t) = {
+    &Vfp11Interp::fmacs, &Vfp11Interp::fnmacs, &Vfp11Interp::fmscs, &Vfp11Interp::fnmscs, // 0x0-0x3
+    &Vfp11Interp::fmuls, &Vfp11Interp::fnmuls, &Vfp11Interp::fadds, &Vfp11Interp::fsubs, // 0x4-0x7
+    &Vfp11Interp::fdivs, nullptr, nullptr, nullptr, // 0x8-0xB
+    nullptr, nullptr, nullptr, &Vfp11Interp::extOperS // 0xC-0xF
+};
+
+// VFP11 double data operation lookup table, using bits p, q, r, and s of an opcode
+void (Vfp11Interp::*Vfp11Interp::dataInstrsD[])(uint8_t, uint8_t, uint8_t) = {
+    &Vfp11Interp::fmacd, &Vfp11Interp::fnmacd, &Vfp11Interp::fmscd, &Vfp11Interp::fnmscd, // 0x0-0x3
+    &Vfp11Interp::fmuld, &Vfp11Interp::fnmuld, &Vfp11Interp::faddd, &Vfp11Interp::fsubd, // 0x4-0x7
+    &Vfp11Interp::fdivd, nullptr, nullptr, nullptr, // 0x8-0xB
+    nullptr, nullptr, nullptr, &Vfp11Interp::extOperD // 0xC-0xF
+};
+
+// VFP10 single data operation extension lookup table, using the Fn bits of an opcode
+// TODO: use separate functions for compare E-variants and conversion Z-variants
+void (Vfp11Interp::*Vfp11Interp::extInstrsS[])(uint8_t, uint8_t) = {
+    &Vfp11Interp::fcpys, &Vfp11Interp::fabss, &Vfp11Interp::fnegs, &Vfp11Interp::fsqrts, // 0x00-0x03
+    nullptr, nullptr, nullptr, nullptr, // 0x04-0x07
+    &Vfp11Interp::fcmps, &Vfp11Interp::fcmps, &Vfp11Interp::fcmpzs, &Vfp11Interp::fcmpzs, // 0x08-0x0B
+    nullptr, nullptr, nullptr, &Vfp11Interp::fcvtds, // 0x0C-0x0F
+    &Vfp11Interp::fuitos, &Vfp11Interp::fsitos, nullptr, nullptr, // 0x10-0x13
+    nullptr, nullptr, nullptr, nullptr, // 0x14-0x17
+    &Vfp11Interp::ftouis, &Vfp11Interp::ftouis, &Vfp11Interp::ftosis, &Vfp11Interp::ftosis, // 0x18-0x1B
+    nullptr, nullptr, nullptr, nullptr // 0x1C-0x1F
+};
+
+// VFP11 double data operation extension lookup table, using the Fn bits of an opcode
+// TODO: use separate functions for compare E-variants and conversion Z-variants
+void (Vfp11Interp::*Vfp11Interp::extInstrsD[])(uint8_t, uint8_t) = {
+    &Vfp11Interp::fcpyd, &Vfp11Interp::fabsd, &Vfp11Interp::fnegd, &Vfp11Interp::fsqrtd, // 0x00-0x03
+    nullptr, nullptr, nullptr, nullptr, // 0x04-0x07
+    &Vfp11Interp::fcmpd, &Vfp11Interp::fcmpd, &Vfp11Interp::fcmpzd, &Vfp11Interp::fcmpzd, // 0x08-0x0B
+    nullptr, nullptr, nullptr, &Vfp11Interp::fcvtsd, // 0x0C-0x0F
+    &Vfp11Interp::fuitod, &Vfp11Interp::fsitod, nullptr, nullptr, // 0x10-0x13
+    nullptr, nullptr, nullptr, nullptr, // 0x14-0x17
+    &Vfp11Interp::ftouid, &Vfp11Interp::ftouid, &Vfp11Interp::ftosid, &Vfp11Interp::ftosid, // 0x18-0x1B
+    nullptr, nullptr, nullptr, nullptr // 0x1C-0x1F
+};
+
+void Vfp11Interp::serialize(SaveState &s) {
+    // Transfer the VFP registers and vector settings
+    s.io(regs);
+    s.io(fpscr);
+    s.io(fpexc);
+    s.io(vecLength);
+    s.io(vecStride);
+}
+
 void Vfp11Interp::readSingleS(uint8_t cpopc, uint32_t *rd, uint8_t cn, uint8_t cm, uint8_t cp) {
     // Execute a VFP10 single read instruction
     uint8_t sn = (cn << 1) | (cp >> 2);
@@ -167,105 +219,49 @@ void Vfp11Interp::storeMemoryD(uint8_t cpopc, uint8_t cd, uint32_t *rn, uint8_t
 }
 
 void Vfp11Interp::dataOperS(uint8_t cpopc, uint8_t cd, uint8_t cn, uint8_t cm, uint8_t cp) {
-    // Execute a VFP10 data operation instruction
+    // Execute a VFP10 data operation instruction using the lookup table
     uint8_t fd = (cd << 1) | ((cpopc >> 2) & 0x1);
     uint8_t fn = (cn << 1) | ((cp >> 2) & 0x1);
     uint8_t fm = (cm << 1) | ((cp >> 0) & 0x1);
-    switch (uint8_t pqrs = (cpopc & 0x8) | ((cpopc << 1) & 0x6) | ((cp >> 1) & 0x1)) {
-        case 0x0: return fmacs(fd, fn, fm);
-        case 0x1: return fnmacs(fd, fn, fm);
-        case 0x2: return fmscs(fd, fn, fm);
-        case 0x3: return fnmscs(fd, fn, fm);
-        case 0x4: return fmuls(fd, fn, fm);
-        case 0x5: return fnmuls(fd, fn, fm);
-        case 0x6: return fadds(fd, fn, fm);
-        case 0x7: return fsubs(fd, fn, fm);
-        case 0x8: return fdivs(fd, fn, fm);
-
-    case 0xF:
-        // Execute a VFP10 data operation extension instruction
-        switch (uint8_t ext = (cn << 1) | (cp >> 2)) {
-            case 0x00: return fcpys(fd, fm);
-            case 0x01: return fabss(fd, fm);
-            case 0x02: return fnegs(fd, fm);
-            case 0x03: return fsqrts(fd, fm);
-            case 0x08: return fcmps(fd, fm);
-            case 0x09: return fcmps(fd, fm); // TODO: E-variant
-            case 0x0A: return fcmpzs(fd, fm);
-            case 0x0B: return fcmpzs(fd, fm); // TODO: E-variant
-            case 0x0F: return fcvtds(fd, fm);
-            case 0x10: return fuitos(fd, fm);
-            case 0x11: return fsitos(fd, fm);
-            case 0x18: return ftouis(fd, fm);
-            case 0x19: return ftouis(fd, fm); // TODO: Z-variant
-            case 0x1A: return ftosis(fd, fm);
-            case 0x1B: return ftosis(fd, fm); // TODO: Z-variant
-
-        default:
-            // Catch unknown VFP10 data operation extension bits
-            LOG_CRIT("Unknown ARM11 core %d VFP10 data operation extension bits: 0x%X\n", id, ext);
-            return;
-        }
+    uint8_t pqrs = (cpopc & 0x8) | ((cpopc << 1) & 0x6) | ((cp >> 1) & 0x1);
+    if (dataInstrsS[pqrs]) return (this->*dataInstrsS[pqrs])(fd, fn, fm);
 
-    default:
-        // Catch unknown VFP10 data operation opcode bits
-        LOG_CRIT("Unknown ARM11 core %d VFP10 data operation opcode bits: 0x%X\n", id, pqrs);
-        return;
-    }
+    // Catch unknown VFP10 data operation opcode bits
+    LOG_CRIT("Unknown ARM11 core %d VFP10 data operation opcode bits: 0x%X\n", id, pqrs);
 }
 
 void Vfp11Interp::dataOperD(uint8_t cpopc, uint8_t cd, uint8_t cn, uint8_t cm, uint8_t cp) {
-    // Execute a VFP11 data operation instruction
+    // Execute a VFP11 data operation instruction using the lookup table
     uint8_t fd = (cd << 1) | ((cpopc >> 2) & 0x1);
     uint8_t fn = (cn << 1) | ((cp >> 2) & 0x1);
     uint8_t fm = (cm << 1) | ((cp >> 0) & 0x1);
-    switch (uint8_t pqrs = (cpopc & 0x8) | ((cpopc << 1) & 0x6) | ((cp >> 1) & 0x1)) {
-        case 0x0: return fmacd(fd, fn, fm);
-        case 0x1: return fnmacd(fd, fn, fm);
-        case 0x2: return fmscd(fd, fn, fm);
-        case 0x3: return fnmscd(fd, fn, fm);
-        case 0x4: return fmuld(fd, fn, fm);
-        case 0x5: return fnmuld(fd, fn, fm);
-        case 0x6: return faddd(fd, fn, fm);
-        case 0x7: return fsubd(fd, fn, fm);
-        case 0x8: return fdivd(fd, fn, fm);
-
-    case 0xF:
-        // Execute a VFP11 data operation extension instruction
-        switch (uint8_t ext = (cn << 1) | (cp >> 2)) {
-            case 0x00: return fcpyd(fd, fm);
-            case 0x01: return fabsd(fd, fm);
-            case 0x02: return fnegd(fd, fm);
-            case 0x03: return fsqrtd(fd, fm);
-            case 0x08: return fcmpd(fd, fm);
-            case 0x09: return fcmpd(fd, fm); // TODO: E-variant
-            case 0x0A: return fcmpzd(fd, fm);
-            case 0x0B: return fcmpzd(fd, fm); // TODO: E-variant
-            case 0x0F: return fcvtsd(fd, fm);
-            case 0x10: return fuitod(fd, fm);
-            case 0x11: return fsitod(fd, fm);
-            case 0x18: return ftouid(fd, fm);
-            case 0x19: return ftouid(fd, fm); // TODO: Z-variant
-            case 0x1A: return ftosid(fd, fm);
-            case 0x1B: return ftosid(fd, fm); // TODO: Z-variant
-
-        default:
-            // Catch unknown VFP11 data operation extension bits
-            LOG_CRIT("Unknown ARM11 core %d VFP11 data operation extension bits: 0x%X\n", id, ext);
-            return;
-        }
+    uint8_t pqrs = (cpopc & 0x8) | ((cpopc << 1) & 0x6) | ((cp >> 1) & 0x1);
+    if (dataInstrsD[pqrs]) return (this->*dataInstrsD[pqrs])(fd, fn, fm);
 
-    default:
-        // Catch unknown VFP11 data operation opcode bits
-        LOG_CRIT("Unknown ARM11 core %d VFP11 data operation opcode bits: 0x%X\n", id, pqrs);
-        return;
-    }
+    // Catch unknown VFP11 data operation opcode bits
+    LOG_CRIT("Unknown ARM11 core %d VFP11 data operation opcode bits: 0x%X\n", id, pqrs);
+}
+
+void Vfp11Interp::extOperS(uint8_t fd, uint8_t fn, uint8_t fm) {
+    // Execute a VFP10 data operation extension instruction, which uses the Fn bits as an opcode
+    if (extInstrsS[fn]) return (this->*extInstrsS[fn])(fd, fm);
+
+    // Catch unknown VFP10 data operation extension bits
+    LOG_CRIT("Unknown ARM11 core %d VFP10 data operation extension bits: 0x%X\n", id, fn);
+}
+
+void Vfp11Interp::extOperD(uint8_t fd, uint8_t fn, uint8_t fm) {
+    // Execute a VFP11 data operation extension instruction, which uses the Fn bits as an opcode
+    if (extInstrsD[fn]) return (this->*extInstrsD[fn])(fd, fm);
+
+    // Catch unknown VFP11 data operation extension bits
+    LOG_CRIT("Unknown ARM11 core %d VFP11 data operation extension bits: 0x%X\n", id, fn);
 }
 
 bool Vfp11Interp::checkEnable() {
     // Check if the VFP is enabled and trigger an undefined exception if not
     if (fpexc & BIT(30)) return true;
-    *core.arms[id].registers[15] -= 4;
+    core.arms[id].registers[15] -= 4;
     core.arms[id].exception(0x04);
     return false;
 }
@@ -286,10 +282,13 @@ void Vfp11Interp::fmrx(uint32_t *rd, uint8_t sys) { // FMRX Rd,sys
     case 0x02: // FPSCR
         // Read from FPSCR if enabled, or move VFP flags to ARM for FMSTAT
         if (!checkEnable()) return;
-        if (rd == core.arms[id].registers[15]) // FMSTAT
+        if (rd == &core.arms[id].registers[15]) { // FMSTAT
+            core.arms[id].updateFlags();
             core.arms[id].cpsr = (core.arms[id].cpsr & ~0xF0000000) | (fpscr & 0xF0000000);
-        else
+        }
+        else {
             *rd = fpscr;
+        }
         return;
 
     default:
@@ -327,6 +326,38 @@ void Vfp11Interp::fmxr(uint8_t sys, uint32_t rd) { // FMXR sys,Rd
     }
 }
 
+FORCE_INLINE void Vfp11Interp::loadBlock(uint8_t fd, uint32_t address, uint8_t ofs) {
+    // Load registers straight from host memory if the block is aligned and within one page
+    if (!(address & 0x3) && (address & 0xFFF) + (ofs << 2) <= 0x1000) {
+        if (uint8_t *data = core.cp15.getReadPtr(id, address)) {
+            data += (address & 0xFFF);
+            for (int i = 0; i < ofs; i++)
+                regs.u32[(fd + i) & 0x1F] = U8TO32(data, i << 2);
+            return;
+        }
+    }
+
+    // Fall back to loading each register separately
+    for (int i = 0; i < ofs; i++)
+        regs.u32[(fd + i) & 0x1F] = core.cp15.read<uint32_t>(id, address + (i << 2));
+}
+
+FORCE_INLINE void Vfp11Interp::storeBlock(uint8_t fd, uint32_t address, uint8_t ofs) {
+    // Store registers straight to host memory if the block is aligned and within one page
+    if (!(address & 0x3) && (address & 0xFFF) + (ofs << 2) <= 0x1000) {
+        if (uint8_t *data = core.cp15.getWritePtr(id, address)) {
+            data += (address & 0xFFF);
+            for (int i = 0; i < ofs; i++)
+                U8TO32(data, i << 2) = regs.u32[(fd + i) & 0x1F];
+            return;
+        }
+    }
+
+    // Fall back to storing each register separately
+    for (int i = 0; i < ofs; i++)
+        core.cp15.write<uint32_t>(id, address + (i << 2), regs.u32[(fd + i) & 0x1F]);
+}
+
 void Vfp11Interp::fldsP(uint8_t fd, uint32_t rn, uint8_t ofs) { // FLDS Fd,[Rn,+ofs]
     // Load a single register from memory with positive offset if enabled
     if (!checkEnable()) return;
@@ -356,15 +387,13 @@ void Vfp11Interp::flddM(uint8_t fd, uint32_t rn, uint8_t ofs) { // FLDD Fd,[Rn,-
 void Vfp11Interp::fldmia(uint8_t fd, uint32_t rn, uint8_t ofs) { // FLDMIA Rn,<Flist>
     // Load multiple VFP registers from memory with post-increment if enabled
     if (!checkEnable()) return;
-    for (int i = 0; i < ofs; i++)
-        regs.u32[(fd + i) & 0x1F] = core.cp15.read<uint32_t>(id, rn + (i << 2));
+    loadBlock(fd, rn, ofs);
 }
 
 void Vfp11Interp::fldmiaW(uint8_t fd, uint32_t *rn, uint8_t ofs) { // FLDMIA Rn!,<Flist>
     // Load multiple VFP registers from memory with post-increment and writeback if enabled
     if (!checkEnable()) return;
-    for (int i = 0; i < ofs; i++)
-        regs.u32[(fd + i) & 0x1F] = core.cp15.read<uint32_t>(id, *rn + (i << 2));
+    loadBlock(fd, *rn, ofs);
     *rn += (ofs << 2);
 }
 
@@ -372,8 +401,7 @@ void Vfp11Interp::fldmdbW(uint8_t fd, uint32_t *rn, uint8_t ofs) { // FLDMDB Rn!
     // Load multiple VFP registers from memory with pre-decrement and writeback if enabled
     if (!checkEnable()) return;
     *rn -= (ofs << 2);
-    for (int i = 0; i < ofs; i++)
-        regs.u32[(fd + i) & 0x1F] = core.cp15.read<uint32_t>(id, *rn + (i << 2));
+    loadBlock(fd, *rn, ofs);
 }
 
 void Vfp11Interp::fstsP(uint8_t fd, uint32_t rn, uint8_t ofs) { // FSTS Fd,[Rn,+ofs]
@@ -405,15 +433,13 @@ void Vfp11Interp::fstdM(uint8_t fd, uint32_t rn, uint8_t ofs) { // FSTD Fd,[Rn,-
 void Vfp11Interp::fstmia(uint8_t fd, uint32_t rn, uint8_t ofs) { // FSTMIA Rn,<Flist>
     // Store multiple VFP registers to memory with post-increment if enabled
     if (!checkEnable()) return;
-    for (int i = 0; i < ofs; i++)
-        core.cp15.write<uint32_t>(id, rn + (i << 2), regs.u32[(fd + i) & 0x1F]);
+    storeBlock(fd, rn, ofs);
 }
 
 void Vfp11Interp::fstmiaW(uint8_t fd, uint32_t *rn, uint8_t ofs) { // FSTMIA Rn!,<Flist>
     // Store multiple VFP registers to memory with post-increment and writeback if enabled
     if (!checkEnable()) return;
-    for (int i = 0; i < ofs; i++)
-        core.cp15.write<uint32_t>(id, *rn + (i << 2), regs.u32[(fd + i) & 0x1F]);
+    storeBlock(fd, *rn, ofs);
     *rn += (ofs << 2);
 }
 
@@ -421,8 +447,67 @@ void Vfp11Interp::fstmdbW(uint8_t fd, uint32_t *rn, uint8_t ofs) { // FSTMDB Rn!
     // Store multiple VFP registers to memory with pre-decrement and writeback if enabled
     if (!checkEnable()) return;
     *rn -= (ofs << 2);
-    for (int i = 0; i < ofs; i++)
-        core.cp15.write<uint32_t>(id, *rn + (i << 2), regs.u32[(fd + i) & 0x1F]);
+    storeBlock(fd, *rn, ofs);
+}
+
+// Clear the sign bit of a scalar or every lane of a vector
+static FORCE_INLINE float absLanes(float value) { return fabsf(value); }
+static FORCE_INLINE double absLanes(double value) { return fabs(value); }
+static FORCE_INLINE VecS absLanes(VecS value) { for (int i = 0; i < 4; i++) value[i] = fabsf(value[i]); return value; }
+static FORCE_INLINE VecD absLanes(VecD value) { for (int i = 0; i < 2; i++) value[i] = fabs(value[i]); return value; }
+
+// Take the square root of a scalar or every lane of a vector
+static FORCE_INLINE float sqrtLanes(float value) { return sqrtf(value); }
+static FORCE_INLINE double sqrtLanes(double value) { return sqrt(value); }
+static FORCE_INLINE VecS sqrtLanes(VecS value) { for (int i = 0; i < 4; i++) value[i] = sqrtf(value[i]); return value; }
+static FORCE_INLINE VecD sqrtLanes(VecD value) { for (int i = 0; i < 2; i++) value[i] = sqrt(value[i]); return value; }
+
+FORCE_INLINE bool Vfp11Interp::vecContigS(uint8_t fd) {
+    // Check if a single vector fills whole 4-lane chunks in place, without striding or wrapping
+    return !(vecLength & 0x3) && !vecStride && (fd & 0x7) + vecLength <= 8;
+}
+
+FORCE_INLINE bool Vfp11Interp::vecContigD(uint8_t fd) {
+    // Check if a double vector fills whole 2-lane chunks in place, without striding or wrapping
+    return !(vecLength & 0x1) && !vecStride && ((fd >> 1) & 0x3) + vecLength <= 4;
+}
+
+FORCE_INLINE VecS Vfp11Interp::vecLoadS(uint8_t fd) {
+    // Load 4 lanes of a single vector straight from the registers
+    VecS value;
+    memcpy(&value, &regs.flt[fd], sizeof(value));
+    return value;
+}
+
+FORCE_INLINE VecD Vfp11Interp::vecLoadD(uint8_t fd) {
+    // Load 2 lanes of a double vector straight from the registers
+    VecD value;
+    memcpy(&value, &regs.dbl[fd >> 1], sizeof(value));
+    return value;
+}
+
+FORCE_INLINE VecS Vfp11Interp::vecLoadS(uint8_t fm, int i) {
+    // Load lanes of a single vector operand, or repeat a scalar operand from bank 0
+    if (fm >= 8) return vecLoadS(fm + i);
+    VecS value = { regs.flt[fm], regs.flt[fm], regs.flt[fm], regs.flt[fm] };
+    return value;
+}
+
+FORCE_INLINE VecD Vfp11Interp::vecLoadD(uint8_t fm, int i) {
+    // Load lanes of a double vector operand, or repeat a scalar operand from bank 0
+    if (fm >= 8) return vecLoadD(fm + (i << 1));
+    VecD value = { regs.dbl[fm >> 1], regs.dbl[fm >> 1] };
+    return value;
+}
+
+FORCE_INLINE void Vfp11Interp::vecStoreS(uint8_t fd, VecS value) {
+    // Store 4 lanes of a single vector straight to the registers
+    memcpy(&regs.flt[fd], &value, sizeof(value));
+}
+
+FORCE_INLINE void Vfp11Interp::vecStoreD(uint8_t fd, VecD value) {
+    // Store 2 lanes of a double vector straight to the registers
+    memcpy(&regs.dbl[fd >> 1], &value, sizeof(value));
 }
 
 // Perform a single data operation in scalar, mixed, or vector mode if enabled
@@ -431,6 +516,10 @@ void Vfp11Interp::fstmdbW(uint8_t fd, uint32_t *rn, uint8_t ofs) { // FSTMDB Rn!
     if (vecLength == 1 || fd < 8) { \
         regs.flt[fd] = sign(regs.flt[fn] op0 regs.flt[fm]); \
     } \
+    else if (vecContigS(fd) && vecContigS(fn) && (fm < 8 || vecContigS(fm))) { \
+        for (int i = 0; i < vecLength; i += 4) \
+            vecStoreS(fd + i, sign(vecLoadS(fn + i) op0 vecLoadS(fm, i))); \
+    } \
     else if (fm < 8) { \
         float *bd = &regs.flt[fd & 0x18], *bn = &regs.flt[fn & 0x18]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
@@ -455,6 +544,10 @@ FDOPS_FUNC(fnmuls, -, *) // FNMULS Fd,Fn,Fm
     if (vecLength == 1 || fd < 8) { \
         regs.flt[fd] = sign(regs.flt[fn] op0 regs.flt[fm]) op1 regs.flt[fd]; \
     } \
+    else if (vecContigS(fd) && vecContigS(fn) && (fm < 8 || vecContigS(fm))) { \
+        for (int i = 0; i < vecLength; i += 4) \
+            vecStoreS(fd + i, sign(vecLoadS(fn + i) op0 vecLoadS(fm, i)) op1 vecLoadS(fd + i)); \
+    } \
     else if (fm < 8) { \
         float *bd = &regs.flt[fd & 0x18], *bn = &regs.flt[fn & 0x18]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
@@ -478,10 +571,14 @@ FDOCS_FUNC(fnmscs, -, *, -) // FNMSCS Fd,Fn,Fm
     if (vecLength == 1 || fd < 8) { \
         regs.dbl[fd >> 1] = sign(regs.dbl[fn >> 1] op0 regs.dbl[fm >> 1]); \
     } \
+    else if (vecContigD(fd) && vecContigD(fn) && (fm < 8 || vecContigD(fm))) { \
+        for (int i = 0; i < vecLength; i += 2) \
+            vecStoreD(fd + (i << 1), sign(vecLoadD(fn + (i << 1)) op0 vecLoadD(fm, i))); \
+    } \
     else if (fm < 8) { \
         double *bd = &regs.dbl[(fd >> 1) & 0xC], *bn = &regs.dbl[(fn >> 1) & 0xC]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
-            bd[((fd >> 1) + i) & 0x3] = sign(bn[((fn >> 1) + i) & 0x3] op0 regs.dbl[fm]); \
+            bd[((fd >> 1) + i) & 0x3] = sign(bn[((fn >> 1) + i) & 0x3] op0 regs.dbl[fm >> 1]); \
     } \
     else { \
         double *bd = &regs.dbl[(fd >> 1) & 0xC], *bn = &regs.dbl[(fn >> 1) & 0xC], *bm = &regs.dbl[(fm >> 1) & 0xC]; \
@@ -502,6 +599,10 @@ FDOPD_FUNC(fnmuld, -, *) // FNMULD Fd,Fn,Fm
     if (vecLength == 1 || fd < 8) { \
         regs.dbl[fd >> 1] = sign(regs.dbl[fn >> 1] op0 regs.dbl[fm >> 1]) op1 regs.dbl[fd >> 1]; \
     } \
+    else if (vecContigD(fd) && vecContigD(fn) && (fm < 8 || vecContigD(fm))) { \
+        for (int i = 0; i < vecLength; i += 2) \
+            vecStoreD(fd + (i << 1), sign(vecLoadD(fn + (i << 1)) op0 vecLoadD(fm, i)) op1 vecLoadD(fd + (i << 1))); \
+    } \
     else if (fm < 8) { \
         double *bd = &regs.dbl[(fd >> 1) & 0xC], *bn = &regs.dbl[(fn >> 1) & 0xC]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
@@ -527,6 +628,10 @@ FDOCD_FUNC(fnmscd, -, *, -) // FNMSCD Fd,Fn,Fm
     if (vecLength == 1 || fd < 8) { \
         regs.flt[fd] = op0(regs.flt[fm]); \
     } \
+    else if (vecContigS(fd) && (fm < 8 || vecContigS(fm))) { \
+        for (int i = 0; i < vecLength; i += 4) \
+            vecStoreS(fd + i, op0(vecLoadS(fm, i))); \
+    } \
     else if (fm < 8) { \
         float *bd = &regs.flt[fd & 0x18]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
@@ -540,9 +645,9 @@ FDOCD_FUNC(fnmscd, -, *, -) // FNMSCD Fd,Fn,Fm
 }
 
 FDOES_FUNC(fcpys, +) // FCPYS Fd,Fm
-FDOES_FUNC(fabss, fabsf) // FABSS Fd,Fm
+FDOES_FUNC(fabss, absLanes) // FABSS Fd,Fm
 FDOES_FUNC(fnegs, -) // FNEGS Fd,Fm
-FDOES_FUNC(fsqrts, sqrtf) // FSQRTS Fd,Fm
+FDOES_FUNC(fsqrts, sqrtLanes) // FSQRTS Fd,Fm
 
 void Vfp11Interp::fcmps(uint8_t fd, uint8_t fm) { // FCMPS Fd,Fm
     // Compare a single register with another and set flags if enabled
@@ -601,6 +706,10 @@ void Vfp11Interp::ftosis(uint8_t fd, uint8_t fm) { // FTOSIS Id,Fm
     if (vecLength == 1 || fd < 8) { \
         regs.dbl[fd >> 1] = op0(regs.dbl[fm >> 1]); \
     } \
+    else if (vecContigD(fd) && (fm < 8 || vecContigD(fm))) { \
+        for (int i = 0; i < vecLength; i += 2) \
+            vecStoreD(fd + (i << 1), op0(vecLoadD(fm, i))); \
+    } \
     else if (fm < 8) { \
         double *bd = &regs.dbl[(fd >> 1) & 0xC]; \
         for (int i = 0; i < (vecLength << vecStride); i += (1 << vecStride)) \
@@ -614,9 +723,9 @@ void Vfp11Interp::ftosis(uint8_t fd, uint8_t fm) { // FTOSIS Id,Fm
 }
 
 FDOED_FUNC(fcpyd, +) // FCPYD Fd,Fm
-FDOED_FUNC(fabsd, fabs) // FABSD Fd,Fm
+FDOED_FUNC(fabsd, absLanes) // FABSD Fd,Fm
 FDOED_FUNC(fnegd, -) // FNEGD Fd,Fm
-FDOED_FUNC(fsqrtd, sqrt) // FSQRTD Fd,Fm
+FDOED_FUNC(fsqrtd, sqrtLanes) // FSQRTD Fd,Fm
 
 void Vfp11Interp::fcmpd(uint8_t fd, uint8_t fm) { // FCMPD Fd,Fm
     // Compare a double register with another and set flags if enabled
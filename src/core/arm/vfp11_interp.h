@@ -23,10 +23,16 @@
 #include "../defines.h"
 
 class Core;
+class SaveState;
+
+// Host vectors for running VFP short vectors in chunks, which compile to SSE on x86 or NEON on ARM
+typedef float VecS __attribute__((vector_size(16)));
+typedef double VecD __attribute__((vector_size(16)));
 
 class Vfp11Interp {
 public:
     Vfp11Interp(Core &core, CpuId id): core(core), id(id) {}
+    void serialize(SaveState &s);
 
     void readSingleS(uint8_t cpopc, uint32_t *rd, uint8_t cn, uint8_t cm, uint8_t cp);
     void readSingleD(uint8_t cpopc, uint32_t *rd, uint8_t cn, uint8_t cm, uint8_t cp);
@@ -63,7 +69,25 @@ private:
     uint8_t vecLength = 1;
     bool vecStride = false;
 
+    static void (Vfp11Interp::*dataInstrsS[0x10])(uint8_t, uint8_t, uint8_t);
+    static void (Vfp11Interp::*dataInstrsD[0x10])(uint8_t, uint8_t, uint8_t);
+    static void (Vfp11Interp::*extInstrsS[0x20])(uint8_t, uint8_t);
+    static void (Vfp11Interp::*extInstrsD[0x20])(uint8_t, uint8_t);
+
     bool checkEnable();
+    void loadBlock(uint8_t fd, uint32_t address, uint8_t ofs);
+    void storeBlock(uint8_t fd, uint32_t address, uint8_t ofs);
+    bool vecContigS(uint8_t fd);
+    bool vecContigD(uint8_t fd);
+    VecS vecLoadS(uint8_t fd);
+    VecD vecLoadD(uint8_t fd);
+    VecS vecLoadS(uint8_t fm, int i);
+    VecD vecLoadD(uint8_t fm, int i);
+    void vecStoreS(uint8_t fd, VecS value);
+    void vecStoreD(uint8_t fd, VecD value);
+
+    void extOperS(uint8_t fd, uint8_t fn, uint8_t fm);
+    void extOperD(uint8_t fd, uint8_t fn, uint8_t fm);
 
     void fmrs(uint32_t *rd, uint8_t sn);
     void fmrx(uint32_t *rd, uint8_t sys);
@@ -44,6 +44,33 @@ Aes::Aes(Core &core): core(core) {
     }
 }
 
+void Aes::serialize(SaveState &s) {
+    // Transfer the AES keys, FIFOs, and registers
+    s.io(iconOffset);
+    s.io(hackCount);
+    s.io(keys);
+    s.io(keysX);
+    s.io(keysY);
+    s.io(rKey);
+    s.io(ctr);
+    s.io(cbc);
+    s.io(curBlock);
+    s.io(curExtra);
+    s.io(curKey);
+    s.io(writeFifo);
+    s.io(readFifo);
+    s.io(keyFifo);
+    s.io(keyXFifo);
+    s.io(keyYFifo);
+    s.io(aesCnt);
+    s.io(aesBlkcnt);
+    s.io(aesRdfifo);
+    s.io(aesKeysel);
+    s.io(aesKeycnt);
+    s.io(aesIv);
+    s.io(aesMac);
+}
+
 uint32_t Aes::scatter8(uint8_t *t, uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
     // Perform a scatter operation with an 8-bit table
     return (t[(d >> 24) & 0xFF] << 24) | (t[(c >> 16) & 0xFF] << 16) | (t[(b >> 8) & 0xFF] << 8) | t[a & 0xFF];
@@ -181,9 +208,7 @@ void Aes::initFifo() {
 
 void Aes::triggerFifo() {
     // Schedule a FIFO update if one hasn't been already
-    if (scheduled) return;
-    core.schedule(AES_UPDATE, 1);
-    scheduled = true;
+    core.scheduleOnce(AES_UPDATE, 1);
 }
 
 void Aes::update() {
@@ -321,7 +346,6 @@ void Aes::update() {
 
     // Update the AES FIFO sizes
     aesCnt = (aesCnt & ~0x3FF) | (std::min<uint8_t>(16, readFifo.size()) << 5) | writeFifo.size();
-    scheduled = false;
 
     // Set or clear AES in DRQs
     if (writeFifo.size() <= ((aesCnt >> 10) & 0xC)) {
@@ -23,10 +23,12 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 class Aes {
 public:
     Aes(Core &core);
+    void serialize(SaveState &s);
 
     void autoBoot();
     void update();
@@ -55,7 +57,6 @@ private:
 
     int16_t iconOffset = 0;
     uint8_t hackCount = 0;
-    bool scheduled = false;
 
     uint8_t fsBox[0x100];
     uint8_t rsBox[0x100];
@@ -20,6 +20,16 @@
 #include <cstring>
 #include "../core.h"
 
+void Rsa::serialize(SaveState &s) {
+    // Transfer the RSA FIFOs and registers
+    for (int i = 0; i < 4; i++)
+        s.io(expFifos[i]);
+    s.io(rsaCnt);
+    s.io(rsaSlotcnt);
+    s.io(rsaMods);
+    s.io(rsaData);
+}
+
 void Rsa::calculate() {
     // Get the exponent and set initial large numbers for RSA calculation
     std::deque<uint32_t> &exp = expFifos[(rsaCnt >> 4) & 0x3];
@@ -23,10 +23,12 @@
 #include <deque>
 
 class Core;
+class SaveState;
 
 class Rsa {
 public:
     Rsa(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     uint32_t readCnt() { return rsaCnt; }
     uint32_t readSlotcnt(int i) { return rsaSlotcnt[i]; }
@@ -20,6 +20,19 @@
 #include <cstring>
 #include "../core.h"
 
+void Sha::serialize(SaveState &s) {
+    // Transfer the SHA FIFOs and registers
+    s.io(iconFlags);
+    s.io(inFifo);
+    s.io(outFifo);
+    s.io(fifoValue);
+    s.io(fifoMask);
+    s.io(fifoRunning);
+    s.io(shaCnt);
+    s.io(shaBlkcnt);
+    s.io(shaHash);
+}
+
 void Sha::hash1(uint32_t *src) {
     // Generate the rest of the input based on existing values
     for (int i = 16; i < 80; i++) {
@@ -139,9 +152,7 @@ void Sha::pushFifo() {
 
 void Sha::triggerFifo() {
     // Schedule a FIFO update if one hasn't been already
-    if (scheduled) return;
-    core.schedule(Task(SHA0_UPDATE + arm9), 1);
-    scheduled = true;
+    core.scheduleOnce(Task(SHA0_UPDATE + arm9), 1);
 }
 
 void Sha::update() {
@@ -231,7 +242,6 @@ void Sha::update() {
     }
 
     // Disable the FIFO after the final block is processed
-    scheduled = false;
     if (!(shaCnt & (fifoRunning << 1))) return;
     shaCnt &= ~BIT(1);
     fifoRunning = false;
@@ -23,12 +23,14 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 class Sha {
 public:
     uint32_t iconFlags = -1;
 
     Sha(Core &core, bool arm9): core(core), arm9(arm9) {}
+    void serialize(SaveState &s);
     void update();
 
     uint32_t readCnt() { return shaCnt; }
@@ -44,7 +46,6 @@ public:
 private:
     Core &core;
     bool arm9;
-    bool scheduled = false;
 
     std::queue<uint32_t> inFifo;
     std::queue<uint32_t> outFifo;
@@ -19,6 +19,27 @@
 
 #include "../core.h"
 
+void Y2r::serialize(SaveState &s) {
+    // Transfer the Y2R FIFOs, line buffer, and registers
+    for (int i = 0; i < 3; i++)
+        s.io(inputs[i]);
+    s.io(output);
+    s.io(lineBuf);
+    s.io(outputLines);
+    s.io(y2rCnt);
+    s.io(y2rWidth);
+    s.io(y2rHeight);
+    s.io(y2rMultiplyY);
+    s.io(y2rMultiplyVr);
+    s.io(y2rMultiplyVg);
+    s.io(y2rMultiplyUg);
+    s.io(y2rMultiplyUb);
+    s.io(y2rOffsetR);
+    s.io(y2rOffsetG);
+    s.io(y2rOffsetB);
+    s.io(y2rAlpha);
+}
+
 void Y2r::outputPixel(uint32_t ofs, uint8_t y, uint8_t u, uint8_t v) {
     // Swizzle the pixel buffer offset if enabled
     if (y2rCnt & BIT(12)) {
@@ -74,9 +95,7 @@ void Y2r::outputPixel(uint32_t ofs, uint8_t y, uint8_t u, uint8_t v) {
 
 void Y2r::triggerFifo() {
     // Schedule a FIFO update if one hasn't been already
-    if (scheduled) return;
-    core.schedule(Task(Y2R0_UPDATE + id), 1);
-    scheduled = true;
+    core.scheduleOnce(Task(Y2R0_UPDATE + id), 1);
 }
 
 void Y2r::update() {
@@ -169,7 +188,6 @@ finish:
     // Trigger an ARM11 general interrupt if enabled and any condition was set
     if ((y2rCnt & BIT(29)) && (y2rCnt & 0x1F000000))
         core.interrupts.sendInterrupt(ARM11, id ? 0x4E : 0x4B);
-    scheduled = false;
 }
 
 uint32_t Y2r::readOutputRgba() {
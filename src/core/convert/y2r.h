@@ -23,10 +23,12 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 class Y2r {
 public:
     Y2r(Core &core, bool id): core(core), id(id) {}
+    void serialize(SaveState &s);
     void update();
 
     uint32_t readCnt() { return y2rCnt; }
@@ -67,7 +69,6 @@ private:
     std::queue<uint8_t> output;
     uint32_t lineBuf[0x2000] = {};
     uint16_t outputLines = 0;
-    bool scheduled = false;
 
     uint32_t y2rCnt = 0;
     uint16_t y2rWidth = 0;
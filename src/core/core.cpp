@@ -18,13 +18,24 @@
 */
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sys/stat.h>
 #include "core.h"
 
+// Identify save states and reject ones from incompatible versions
+#define STATE_MAGIC 0x54534233 // "3BST"
+#define STATE_VERSION 4
+
+// Bind a task to a member function call through a plain function pointer
+#define DEF_TASK(task, type, object, call) \
+    tasks[task] = TaskFunc([](void *obj) { ((type*)obj)->call; }, object)
+
 Core::Core(std::string &cartPath, std::function<void()> *contextFunc): aes(*this), arms { ArmInterp(*this, ARM11A),
         ArmInterp(*this, ARM11B), ArmInterp(*this, ARM11C), ArmInterp(*this, ARM11D), ArmInterp(*this, ARM9) },
         cartridge(*this, cartPath), cdmas { Cdma(*this, CDMA0), Cdma(*this, CDMA1), Cdma(*this, XDMA) }, cp15(*this),
         csnd(*this), gpu(*this, contextFunc), i2c(*this), input(*this), interrupts(*this), memory(*this),
-        ndma(*this), pdc(*this), pxi(*this), rsa(*this), sdMmcs { SdMmc(*this), SdMmc(*this) }, shas { Sha(*this,
+        ndma(*this), pdc(*this), profiler(*this), pxi(*this), rsa(*this), sdMmcs { SdMmc(*this), SdMmc(*this) }, shas { Sha(*this,
         0), Sha(*this, 1) }, timers(*this), vfp11s { Vfp11Interp(*this, ARM11A), Vfp11Interp(*this, ARM11B),
         Vfp11Interp(*this, ARM11C), Vfp11Interp(*this, ARM11D) }, wifi(*this), y2rs { Y2r(*this, 0), Y2r(*this, 1) } {
     // Initialize things that need to be done after construction
@@ -35,59 +46,112 @@ Core::Core(std::string &cartPath, std::function<void()> *contextFunc): aes(*this
         arms[i].init();
     initDsp();
 
+    // Set the CPU slice length, or run in lockstep if zero
+    static const uint32_t quantums[] = { 0, 64, 256, 1024 };
+    cpuQuantum = quantums[std::min<uint32_t>(Settings::cpuTiming, 3)];
+
+    // Run ARM11 cores, the ARM9, or the DSP on separate threads if enabled, which always uses slices
+    threadedArm11 = Settings::threadedArm11;
+    threadedArm9 = Settings::threadedArm9;
+    threadedDsp = Settings::threadedDsp;
+    if (threadedArm11 || threadedArm9 || threadedDsp) {
+        if (!cpuQuantum) cpuQuantum = 1024;
+        memory.atomicTags = true;
+    }
+
+    // Run ARM11 code through the JIT or cached interpreter if enabled, which always uses slices
+    // The JIT needs an x86-64 host, so the cached interpreter is used in its place elsewhere
+    if (Settings::cpuBackend) {
+        if (!cpuQuantum) cpuQuantum = 1024;
+#ifdef ARM_JIT
+        bool native = (Settings::cpuBackend == 1);
+#else
+        bool native = false;
+#endif
+        for (int i = 0; i < MAX_CPUS - 1; i++)
+            arms[i].jit = new ArmJit(*this, arms[i], native);
+    }
+
+    // Replace known memory routines in ARM11 code with native versions if enabled
+    if (Settings::armHle) {
+        for (int i = 0; i < MAX_CPUS - 1; i++)
+            arms[i].hle = new ArmHle(*this, arms[i]);
+    }
+    updateRunFunc();
+
     // Define static tasks that can be scheduled
-    tasks[RESET_CYCLES] = std::bind(&Core::resetCycles, this);
-    tasks[END_FRAME] = std::bind(&Core::endFrame, this);
-    tasks[UPDATE_RUN_FUNC] = std::bind(&Core::updateRunFunc, this);
-    tasks[ARM_STOP_CYCLES] = std::bind(&ArmInterp::stopCycles, this);
-    tasks[ARM11A_INTERRUPT] = std::bind(&Interrupts::interrupt, &interrupts, ARM11A);
-    tasks[ARM11B_INTERRUPT] = std::bind(&Interrupts::interrupt, &interrupts, ARM11B);
-    tasks[ARM11C_INTERRUPT] = std::bind(&Interrupts::interrupt, &interrupts, ARM11C);
-    tasks[ARM11D_INTERRUPT] = std::bind(&Interrupts::interrupt, &interrupts, ARM11D);
-    tasks[ARM9_INTERRUPT] = std::bind(&Interrupts::interrupt, &interrupts, ARM9);
-    tasks[TMR11A_UNDERFLOW0] = std::bind(&Timers::underflowMp, &timers, ARM11A, 0);
-    tasks[TMR11A_UNDERFLOW1] = std::bind(&Timers::underflowMp, &timers, ARM11A, 1);
-    tasks[TMR11B_UNDERFLOW0] = std::bind(&Timers::underflowMp, &timers, ARM11B, 0);
-    tasks[TMR11B_UNDERFLOW1] = std::bind(&Timers::underflowMp, &timers, ARM11B, 1);
-    tasks[TMR11C_UNDERFLOW0] = std::bind(&Timers::underflowMp, &timers, ARM11C, 0);
-    tasks[TMR11C_UNDERFLOW1] = std::bind(&Timers::underflowMp, &timers, ARM11C, 1);
-    tasks[TMR11D_UNDERFLOW0] = std::bind(&Timers::underflowMp, &timers, ARM11D, 0);
-    tasks[TMR11D_UNDERFLOW1] = std::bind(&Timers::underflowMp, &timers, ARM11D, 1);
-    tasks[TMR9_OVERFLOW0] = std::bind(&Timers::overflowTm, &timers, 0);
-    tasks[TMR9_OVERFLOW1] = std::bind(&Timers::overflowTm, &timers, 1);
-    tasks[TMR9_OVERFLOW2] = std::bind(&Timers::overflowTm, &timers, 2);
-    tasks[TMR9_OVERFLOW3] = std::bind(&Timers::overflowTm, &timers, 3);
-    tasks[AES_UPDATE] = std::bind(&Aes::update, &aes);
-    tasks[CDMA0_UPDATE] = std::bind(&Cdma::update, &cdmas[CDMA0]);
-    tasks[CDMA1_UPDATE] = std::bind(&Cdma::update, &cdmas[CDMA1]);
-    tasks[XDMA_UPDATE] = std::bind(&Cdma::update, &cdmas[XDMA]);
-    tasks[NDMA_UPDATE] = std::bind(&Ndma::update, &ndma);
-    tasks[SHA0_UPDATE] = std::bind(&Sha::update, &shas[0]);
-    tasks[SHA1_UPDATE] = std::bind(&Sha::update, &shas[1]);
-    tasks[Y2R0_UPDATE] = std::bind(&Y2r::update, &y2rs[0]);
-    tasks[Y2R1_UPDATE] = std::bind(&Y2r::update, &y2rs[1]);
-    tasks[GPU_END_FILL0] = std::bind(&Gpu::endFill, &gpu, 0);
-    tasks[GPU_END_FILL1] = std::bind(&Gpu::endFill, &gpu, 1);
-    tasks[GPU_END_COPY] = std::bind(&Gpu::endCopy, &gpu);
-    tasks[CSND_SAMPLE] = std::bind(&Csnd::runSample, &csnd);
-    tasks[SDMMC0_READ_BLOCK] = std::bind(&SdMmc::readBlock, &sdMmcs[0]);
-    tasks[SDMMC1_READ_BLOCK] = std::bind(&SdMmc::readBlock, &sdMmcs[1]);
-    tasks[SDMMC0_WRITE_BLOCK] = std::bind(&SdMmc::writeBlock, &sdMmcs[0]);
-    tasks[SDMMC1_WRITE_BLOCK] = std::bind(&SdMmc::writeBlock, &sdMmcs[1]);
-    tasks[WIFI_READ_BLOCK] = std::bind(&Wifi::readBlock, &wifi);
-    tasks[WIFI_WRITE_BLOCK] = std::bind(&Wifi::writeBlock, &wifi);
-    tasks[NTR_WORD_READY] = std::bind(&Cartridge::ntrWordReady, &cartridge);
-    tasks[CTR_WORD_READY] = std::bind(&Cartridge::ctrWordReady, &cartridge);
+    DEF_TASK(RESET_CYCLES, Core, this, resetCycles());
+    DEF_TASK(END_FRAME, Core, this, endFrame());
+    DEF_TASK(UPDATE_RUN_FUNC, Core, this, updateRunFunc());
+    tasks[ARM_STOP_CYCLES] = TaskFunc([](void *obj) { ArmInterp::stopCycles((Core*)obj); }, this);
+    DEF_TASK(ARM11A_INTERRUPT, Interrupts, &interrupts, interrupt(ARM11A));
+    DEF_TASK(ARM11B_INTERRUPT, Interrupts, &interrupts, interrupt(ARM11B));
+    DEF_TASK(ARM11C_INTERRUPT, Interrupts, &interrupts, interrupt(ARM11C));
+    DEF_TASK(ARM11D_INTERRUPT, Interrupts, &interrupts, interrupt(ARM11D));
+    DEF_TASK(ARM9_INTERRUPT, Interrupts, &interrupts, interrupt(ARM9));
+    DEF_TASK(TMR11A_UNDERFLOW0, Timers, &timers, underflowMp(ARM11A, 0));
+    DEF_TASK(TMR11A_UNDERFLOW1, Timers, &timers, underflowMp(ARM11A, 1));
+    DEF_TASK(TMR11B_UNDERFLOW0, Timers, &timers, underflowMp(ARM11B, 0));
+    DEF_TASK(TMR11B_UNDERFLOW1, Timers, &timers, underflowMp(ARM11B, 1));
+    DEF_TASK(TMR11C_UNDERFLOW0, Timers, &timers, underflowMp(ARM11C, 0));
+    DEF_TASK(TMR11C_UNDERFLOW1, Timers, &timers, underflowMp(ARM11C, 1));
+    DEF_TASK(TMR11D_UNDERFLOW0, Timers, &timers, underflowMp(ARM11D, 0));
+    DEF_TASK(TMR11D_UNDERFLOW1, Timers, &timers, underflowMp(ARM11D, 1));
+    DEF_TASK(TMR9_OVERFLOW0, Timers, &timers, overflowTm(0));
+    DEF_TASK(TMR9_OVERFLOW1, Timers, &timers, overflowTm(1));
+    DEF_TASK(TMR9_OVERFLOW2, Timers, &timers, overflowTm(2));
+    DEF_TASK(TMR9_OVERFLOW3, Timers, &timers, overflowTm(3));
+    DEF_TASK(AES_UPDATE, Aes, &aes, update());
+    DEF_TASK(CDMA0_UPDATE, Cdma, &cdmas[CDMA0], update());
+    DEF_TASK(CDMA1_UPDATE, Cdma, &cdmas[CDMA1], update());
+    DEF_TASK(XDMA_UPDATE, Cdma, &cdmas[XDMA], update());
+    DEF_TASK(NDMA_UPDATE, Ndma, &ndma, update());
+    DEF_TASK(SHA0_UPDATE, Sha, &shas[0], update());
+    DEF_TASK(SHA1_UPDATE, Sha, &shas[1], update());
+    DEF_TASK(Y2R0_UPDATE, Y2r, &y2rs[0], update());
+    DEF_TASK(Y2R1_UPDATE, Y2r, &y2rs[1], update());
+    DEF_TASK(GPU_END_FILL0, Gpu, &gpu, endFill(0));
+    DEF_TASK(GPU_END_FILL1, Gpu, &gpu, endFill(1));
+    DEF_TASK(GPU_END_COPY, Gpu, &gpu, endCopy());
+    DEF_TASK(CSND_SAMPLE, Csnd, &csnd, runSample());
+    DEF_TASK(SDMMC0_READ_BLOCK, SdMmc, &sdMmcs[0], readBlock());
+    DEF_TASK(SDMMC1_READ_BLOCK, SdMmc, &sdMmcs[1], readBlock());
+    DEF_TASK(SDMMC0_WRITE_BLOCK, SdMmc, &sdMmcs[0], writeBlock());
+    DEF_TASK(SDMMC1_WRITE_BLOCK, SdMmc, &sdMmcs[1], writeBlock());
+    DEF_TASK(WIFI_READ_BLOCK, Wifi, &wifi, readBlock());
+    DEF_TASK(WIFI_WRITE_BLOCK, Wifi, &wifi, writeBlock());
+    DEF_TASK(NTR_WORD_READY, Cartridge, &cartridge, ntrWordReady());
+    DEF_TASK(CTR_WORD_READY, Cartridge, &cartridge, ctrWordReady());
+    DEF_TASK(PROFILE_SAMPLE, Profiler, &profiler, sample());
 
     // Schedule the initial tasks
     schedule(RESET_CYCLES, 0x7FFFFFFFFFFFFFFF);
     schedule(END_FRAME, 268111856 / 60);
     schedule(CSND_SAMPLE, 2048);
+    profiler.restart();
+
+    // Start host threads for CPUs that run separately if enabled
+    ArmInterp::startThreads(*this);
 }
 
 Core::~Core() {
-    // Clean up the DSP
+    // Stop host threads before anything they use is freed
+    ArmInterp::stopThreads(*this);
+
+#if OP_STATS
+    // Write a final handler report before anything is freed
+    writeOpStats();
+#endif
+
+    // Write the sampled guest profile if enabled
+    profiler.write();
+
+    // Clean up the DSP and ARM11 JITs and HLE
     delete dsp;
+    for (int i = 0; i < MAX_CPUS - 1; i++) {
+        delete arms[i].jit;
+        delete arms[i].hle;
+    }
 }
 
 void Core::initDsp() {
@@ -98,10 +162,8 @@ void Core::initDsp() {
     };
 
     // Remove any tasks scheduled for the current DSP
-    for (int i = 0; i < events.size(); i++)
-        for (int j = 0; j < sizeof(dspTasks) / sizeof(Task); j++)
-            if (events[i].task == &tasks[dspTasks[j]])
-                events.erase(events.begin() + i--);
+    for (int i = 0; i < sizeof(dspTasks) / sizeof(Task); i++)
+        cancel(dspTasks[i]);
 
     // Clean up the current DSP
     delete dsp;
@@ -112,29 +174,189 @@ void Core::initDsp() {
     switch (dspCurrent = Settings::dspBackend) {
     default: // Interpreter
         dsp = dspLle = new DspLle(*this);
-        tasks[TEAK_STOP_CYCLES] = std::bind(&TeakInterp::stopCycles, &dspLle->teak);
-        tasks[TEAK_INTERRUPT0] = std::bind(&TeakInterp::interrupt, &dspLle->teak, 0);
-        tasks[TEAK_INTERRUPT1] = std::bind(&TeakInterp::interrupt, &dspLle->teak, 1);
-        tasks[TEAK_INTERRUPT2] = std::bind(&TeakInterp::interrupt, &dspLle->teak, 2);
-        tasks[TEAK_INTERRUPT3] = std::bind(&TeakInterp::interrupt, &dspLle->teak, 3);
-        tasks[DSP_UNDERFLOW0] = std::bind(&DspLle::underflowTmr, dspLle, 0);
-        tasks[DSP_UNDERFLOW1] = std::bind(&DspLle::underflowTmr, dspLle, 1);
-        tasks[DSP_UNSIGNAL0] = std::bind(&DspLle::unsignalTmr, dspLle, 0);
-        tasks[DSP_UNSIGNAL1] = std::bind(&DspLle::unsignalTmr, dspLle, 1);
-        tasks[DSP_SEND_AUDIO] = std::bind(&DspLle::sendAudio, dspLle);
+        DEF_TASK(TEAK_STOP_CYCLES, TeakInterp, &dspLle->teak, stopCycles());
+        DEF_TASK(TEAK_INTERRUPT0, TeakInterp, &dspLle->teak, interrupt(0));
+        DEF_TASK(TEAK_INTERRUPT1, TeakInterp, &dspLle->teak, interrupt(1));
+        DEF_TASK(TEAK_INTERRUPT2, TeakInterp, &dspLle->teak, interrupt(2));
+        DEF_TASK(TEAK_INTERRUPT3, TeakInterp, &dspLle->teak, interrupt(3));
+        DEF_TASK(DSP_UNDERFLOW0, DspLle, dspLle, underflowTmr(0));
+        DEF_TASK(DSP_UNDERFLOW1, DspLle, dspLle, underflowTmr(1));
+        DEF_TASK(DSP_UNSIGNAL0, DspLle, dspLle, unsignalTmr(0));
+        DEF_TASK(DSP_UNSIGNAL1, DspLle, dspLle, unsignalTmr(1));
+        DEF_TASK(DSP_SEND_AUDIO, DspLle, dspLle, sendAudio());
         return;
 
     case 1: // HLE
         dsp = dspHle = new DspHle(*this);
-        tasks[DSP_HLE_UPDATE] = std::bind(&DspHle::update, dspHle);
+        DEF_TASK(DSP_HLE_UPDATE, DspHle, dspHle, update());
         return;
     }
 }
 
+bool Core::saveState(std::string path) {
+    // Open a state file for writing
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    // Write a header with the system setup and files, followed by the full core state
+    SaveState s(file, false);
+    uint32_t header[] = { STATE_MAGIC, STATE_VERSION, n3dsMode, uint32_t(dspCurrent) };
+    uint64_t files[6];
+    getFingerprint(files);
+    s.io(header);
+    s.io(files);
+    serialize(s);
+    fclose(file);
+    return s.ok();
+}
+
+bool Core::loadState(std::string path) {
+    // Open a state file for reading
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    // Ensure the state was made by this version with the same system setup
+    SaveState s(file, true);
+    uint32_t header[4] = {}, expected[] = { STATE_MAGIC, STATE_VERSION, n3dsMode, uint32_t(dspCurrent) };
+    s.io(header);
+    if (!s.ok() || memcmp(header, expected, sizeof(header))) {
+        LOG_WARN("Save state %s doesn't match the current setup\n", path.c_str());
+        fclose(file);
+        return false;
+    }
+
+    // Ensure the state was made with the same cartridge, and with NAND and SD images that haven't changed since
+    uint64_t files[6] = {}, expFiles[6];
+    getFingerprint(expFiles);
+    s.io(files);
+    if (!s.ok() || memcmp(files, expFiles, sizeof(files))) {
+        LOG_WARN("Save state %s was made with different or since modified files\n", path.c_str());
+        fclose(file);
+        return false;
+    }
+
+    // Load the full core state
+    serialize(s);
+    fclose(file);
+    if (!s.ok()) LOG_CRIT("Save state %s ended early; the core is in an unknown state\n", path.c_str());
+    return s.ok();
+}
+
+void Core::getFingerprint(uint64_t *values) {
+    // Identify the cartridge by a hash of its path and its size
+    uint64_t hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < cartridge.cartPath.size(); i++)
+        hash = (hash ^ uint8_t(cartridge.cartPath[i])) * 0x100000001B3;
+    values[0] = hash;
+    values[1] = cartridge.cartSize;
+
+    // Identify the NAND and SD images by size and modification time, flushing writes so the times are current
+    sdMmcs[0].flush();
+    std::string paths[] = { Settings::nandPath, Settings::sdPath };
+    for (int i = 0; i < 2; i++) {
+        struct stat info;
+        bool found = !stat(paths[i].c_str(), &info);
+        values[2 + i * 2] = found ? info.st_size : 0;
+        values[3 + i * 2] = found ? info.st_mtime : 0;
+    }
+}
+
+#if OP_STATS
+bool Core::writeOpStats() {
+    // Open the handler report file, replacing any previous one
+    FILE *file = fopen((Settings::basePath + "/opstats.txt").c_str(), "w");
+    if (!file) return false;
+
+    // Write a section for each CPU, including the Teak if it's running through the interpreter
+    static const char *names[] = { "ARM11 core 0", "ARM11 core 1", "ARM11 core 2", "ARM11 core 3", "ARM9" };
+    for (int i = 0; i < MAX_CPUS; i++)
+        arms[i].writeOpStats(file, names[i]);
+    if (dspCurrent != 1)
+        ((DspLle*)dsp)->teak.writeOpStats(file, "Teak");
+    fclose(file);
+    return true;
+}
+#endif
+
+void Core::serialize(SaveState &s) {
+    // Transfer the CPUs and the registers that memory maps are built from
+    for (int i = 0; i < MAX_CPUS; i++)
+        arms[i].serialize(s);
+    for (int i = 0; i < MAX_CPUS - 1; i++)
+        vfp11s[i].serialize(s);
+    interrupts.serialize(s);
+    cp15.serialize(s);
+    memory.serialize(s);
+    timers.serialize(s);
+
+    // Transfer the remaining hardware components
+    aes.serialize(s);
+    rsa.serialize(s);
+    for (int i = 0; i < 2; i++)
+        shas[i].serialize(s);
+    for (int i = 0; i < 2; i++)
+        y2rs[i].serialize(s);
+    for (int i = 0; i < 3; i++)
+        cdmas[i].serialize(s);
+    ndma.serialize(s);
+    csnd.serialize(s);
+    dsp->serialize(s);
+    gpu.serialize(s);
+    pdc.serialize(s);
+    pxi.serialize(s);
+    i2c.serialize(s);
+    input.serialize(s);
+    cartridge.serialize(s);
+    for (int i = 0; i < 2; i++)
+        sdMmcs[i].serialize(s);
+    wifi.serialize(s);
+
+    // Transfer the scheduler last, replacing anything queued while loading
+    // Live events are stored in the order they run, which is also a valid heap when loaded back
+    if (!s.loading) {
+        events.erase(std::remove_if(events.begin(), events.end(),
+            [this](const Event &event) { return isStale(event); }), events.end());
+        std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return b > a; });
+    }
+    uint32_t count = events.size();
+    bool frameActive = running.load();
+    s.io(frameActive);
+    s.io(globalCycles);
+    s.io(count);
+    if (s.loading) {
+        if (!s.ok()) return;
+        events.assign(count, Event(RESET_CYCLES, 0, 0));
+        memset(pending, 0, sizeof(pending));
+        memset(cancelOrder, 0, sizeof(cancelOrder));
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        s.io(events[i].task);
+        s.io(events[i].cycles);
+    }
+
+    // Rebuild the event order and pending counts, and select a run function for the loaded state
+    if (!s.loading) return;
+    for (uint32_t i = 0; i < count; i++) {
+        events[i].order = i;
+        if (!pending[events[i].task]++)
+            firstCycles[events[i].task] = events[i].cycles;
+    }
+    eventOrder = count;
+    updateNext();
+    profiler.restart();
+    updateRunFunc();
+    running.store(frameActive);
+}
+
 void Core::resetCycles() {
-    // Reset the global cycle count eventually to prevent overflow
+    // Reset the global cycle count eventually to prevent overflow, dropping cancelled events first
+    events.erase(std::remove_if(events.begin(), events.end(),
+        [this](const Event &event) { return isStale(event); }), events.end());
     for (uint32_t i = 0; i < events.size(); i++)
         events[i].cycles -= globalCycles;
+    for (int i = 0; i < MAX_TASKS; i++)
+        if (pending[i]) firstCycles[i] -= globalCycles;
+    std::make_heap(events.begin(), events.end(), std::greater<Event>());
     for (int i = 0; i < MAX_CPUS; i++)
         arms[i].resetCycles();
     dsp->resetCycles();
@@ -164,18 +386,90 @@ void Core::endFrame() {
 }
 
 void Core::updateRunFunc() {
-    // Swap out the run function based on ARM11 cores 2/3 and DSP backend
-    bool dspOff = (dspCurrent == 1 || ((DspLle*)dsp)->teak.cycles == -1);
-    if ((interrupts.cfg11MpBootcnt[0] | interrupts.cfg11MpBootcnt[1]) & BIT(4)) // Cores enabled
-        runFunc = dspOff ? &ArmInterp::runFrame<true, false> : &ArmInterp::runFrame<true, true>;
-    else // Cores disabled
-        runFunc = dspOff ? &ArmInterp::runFrame<false, false> : &ArmInterp::runFrame<false, true>;
+    // Define run functions for each CPU timing mode and combination of ARM11 cores 2/3 and DSP
+    static void (*funcs[3][4])(Core&) = {
+        { &ArmInterp::runFrame<false, false>, &ArmInterp::runFrame<false, true>,
+            &ArmInterp::runFrame<true, false>, &ArmInterp::runFrame<true, true> },
+        { &ArmInterp::runFrameBatch<false, false>, &ArmInterp::runFrameBatch<false, true>,
+            &ArmInterp::runFrameBatch<true, false>, &ArmInterp::runFrameBatch<true, true> },
+        { &ArmInterp::runFrameThreaded<false, false>, &ArmInterp::runFrameThreaded<false, true>,
+            &ArmInterp::runFrameThreaded<true, false>, &ArmInterp::runFrameThreaded<true, true> }
+    };
+
+    // Swap out the run function based on CPU timing, ARM11 cores 2/3, and DSP backend
+    bool coresOn = ((interrupts.cfg11MpBootcnt[0] | interrupts.cfg11MpBootcnt[1]) & BIT(4));
+    bool dspOn = teakActive();
+    bool threaded = (threadedArm11 || threadedArm9 || (threadedDsp && dspOn));
+    runFunc = funcs[threaded ? 2 : (cpuQuantum ? 1 : 0)][(coresOn << 1) | dspOn];
     running.store(false);
 }
 
+void Core::runEvents() {
+    // Jump to the next task and run all that are scheduled now
+    globalCycles = events[0].cycles;
+    while (events[0].cycles <= globalCycles) {
+        // Pop the soonest event off the heap before running it, in case it schedules more
+        Task task = events[0].task;
+        popEvent();
+        dropStale();
+        if (--pending[task])
+            updateFirst(task);
+        updateNext();
+
+        // Count the task as pending while it runs, so triggers raised inside it are merged into it
+        runTask = task;
+        tasks[task]();
+        runTask = MAX_TASKS;
+    }
+}
+
 void Core::schedule(Task task, uint64_t cycles) {
-    // Add a task to the scheduler, sorted by least to most cycles until execution
-    Event event(&tasks[task], globalCycles + cycles);
-    auto it = std::upper_bound(events.cbegin(), events.cend(), event);
-    events.insert(it, event);
+    // Add a task to the scheduler's min-heap, ordered by cycles and then by scheduling order
+    events.push_back(Event(task, globalCycles + cycles, eventOrder++));
+    std::push_heap(events.begin(), events.end(), std::greater<Event>());
+    if (!pending[task]++ || firstCycles[task] > globalCycles + cycles)
+        firstCycles[task] = globalCycles + cycles;
+    updateNext();
+}
+
+void Core::scheduleOnce(Task task, uint64_t cycles) {
+    // Schedule a task only if it isn't running or pending, or move it earlier if the new request is sooner
+    if (task == runTask || (pending[task] && firstCycles[task] <= globalCycles + cycles)) return;
+    reschedule(task, cycles);
+}
+
+void Core::reschedule(Task task, uint64_t cycles) {
+    // Replace any pending instances of a task with a new one
+    cancel(task);
+    schedule(task, cycles);
+}
+
+void Core::cancel(Task task) {
+    // Mark all pending instances of a task as stale, leaving them in the heap until they reach the top
+    if (task == runTask) runTask = MAX_TASKS;
+    if (!pending[task]) return;
+    cancelOrder[task] = eventOrder;
+    pending[task] = 0;
+    dropStale();
+    updateNext();
+}
+
+void Core::popEvent() {
+    // Remove the soonest event from the heap
+    std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+    events.pop_back();
+}
+
+void Core::dropStale() {
+    // Pop cancelled events off the top of the heap so the soonest event is always a live one
+    while (isStale(events[0]))
+        popEvent();
+}
+
+void Core::updateFirst(Task task) {
+    // Find the soonest remaining instance of a task that was queued more than once
+    firstCycles[task] = -1;
+    for (uint32_t i = 0; i < events.size(); i++)
+        if (events[i].task == task && !isStale(events[i]))
+            firstCycles[task] = std::min(firstCycles[task], events[i].cycles);
 }
@@ -21,12 +21,18 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <vector>
 
 #include "defines.h"
+#include "profiler.h"
 #include "settings.h"
+#include "state.h"
+#include "arm/arm_hle.h"
 #include "arm/arm_interp.h"
+#include "arm/arm_jit.h"
 #include "arm/cp15.h"
 #include "arm/interrupts.h"
 #include "arm/timers.h"
@@ -109,15 +115,27 @@ enum Task {
     WIFI_WRITE_BLOCK,
     NTR_WORD_READY,
     CTR_WORD_READY,
+    PROFILE_SAMPLE,
     MAX_TASKS
 };
 
+struct TaskFunc {
+    void (*func)(void*);
+    void *object;
+
+    TaskFunc(): func(nullptr), object(nullptr) {}
+    TaskFunc(void (*func)(void*), void *object): func(func), object(object) {}
+    void operator()() const { (*func)(object); }
+};
+
 struct Event {
-    std::function<void()> *task;
+    Task task;
     uint64_t cycles;
+    uint64_t order;
 
-    Event(std::function<void()> *task, uint64_t cycles): task(task), cycles(cycles) {}
-    bool operator<(const Event &event) const { return cycles < event.cycles; }
+    Event(Task task, uint64_t cycles, uint64_t order): task(task), cycles(cycles), order(order) {}
+    bool operator>(const Event &event) const
+        { return cycles > event.cycles || (cycles == event.cycles && order > event.order); }
 };
 
 class Core {
@@ -139,6 +157,7 @@ public:
     Memory memory;
     Ndma ndma;
     Pdc pdc;
+    Profiler profiler;
     Pxi pxi;
     Rsa rsa;
     SdMmc sdMmcs[2];
@@ -150,17 +169,52 @@ public:
 
     std::atomic<bool> running{false};
     std::vector<Event> events;
+    std::atomic<uint64_t> nextEvent{0};
     uint64_t globalCycles = 0;
+    uint32_t cpuQuantum = 0;
+
+    bool threadedArm11 = false;
+    bool threadedArm9 = false;
+    bool threadedDsp = false;
+    std::recursive_mutex coreMutex;
+    std::thread *threads[MAX_CPUS + 1] = {};
+    std::mutex threadMutex;
+    std::condition_variable threadCond;
+    std::atomic<uint32_t> threadsWaiting{0};
+    std::atomic<uint32_t> sliceIds[MAX_CPUS + 1] = {};
+    std::atomic<uint32_t> sliceLeft{0};
+    std::atomic<bool> slicing{false};
+    std::atomic<uint8_t> wakeups[MAX_CPUS] = {};
+    uint32_t sliceCount = 0;
+    bool threadsStop = false;
+    uint64_t sliceStart = 0, sliceEnd = 0;
 
     Core(std::string &cartPath, std::function<void()> *contextFunc = nullptr);
     ~Core();
 
     void runFrame() { (*runFunc)(*this); }
+    void runEvents();
     void schedule(Task task, uint64_t cycles);
+    void scheduleOnce(Task task, uint64_t cycles);
+    void reschedule(Task task, uint64_t cycles);
+    void cancel(Task task);
+    bool isPending(Task task) { return pending[task] || task == runTask; }
+    bool teakActive() { return dspCurrent != 1 && ((DspLle*)dsp)->teak.cycles != -1; }
     void initDsp();
 
+    bool saveState(std::string path);
+    bool loadState(std::string path);
+#if OP_STATS
+    bool writeOpStats();
+#endif
+
 private:
-    std::function<void()> tasks[MAX_TASKS];
+    TaskFunc tasks[MAX_TASKS];
+    uint16_t pending[MAX_TASKS] = {};
+    uint64_t firstCycles[MAX_TASKS] = {};
+    uint64_t cancelOrder[MAX_TASKS] = {};
+    uint64_t eventOrder = 0;
+    Task runTask = MAX_TASKS;
     void (*runFunc)(Core&) = &ArmInterp::runFrame<false, false>;
     int dspCurrent = 0;
 
@@ -170,4 +224,21 @@ private:
     void resetCycles();
     void endFrame();
     void updateRunFunc();
+    void updateNext() { nextEvent.store(events[0].cycles, std::memory_order_relaxed); }
+    bool isStale(const Event &event) { return event.order < cancelOrder[event.task]; }
+    void popEvent();
+    void dropStale();
+    void updateFirst(Task task);
+    void getFingerprint(uint64_t *values);
+    void serialize(SaveState &s);
+};
+
+class CoreLock {
+public:
+    // Hold the core mutex for a scope, but only if CPUs run on separate threads
+    CoreLock(Core &core): mutex((core.threadedArm11 || core.threadedArm9 || core.threadedDsp) ? &core.coreMutex : nullptr) { if (mutex) mutex->lock(); }
+    ~CoreLock() { if (mutex) mutex->unlock(); }
+
+private:
+    std::recursive_mutex *mutex;
 };
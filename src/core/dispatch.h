@@ -0,0 +1,46 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+// Computed goto dispatch relies on the labels-as-values extension in GCC and Clang
+#if COMPUTED_GOTO && !defined(__GNUC__)
+#error "COMPUTED_GOTO requires GCC or Clang"
+#endif
+
+template <typename T> struct OpLabel {
+    T handler;
+    void *label;
+};
+
+template <typename T> void **mapLabels(T *handlers, size_t size, const OpLabel<T> *labels, size_t count, void *fallback) {
+    // Point each lookup table entry at its handler's label, or at a fallback that calls through the table
+    void **table = new void*[size];
+    for (size_t i = 0; i < size; i++) {
+        table[i] = fallback;
+        for (size_t j = 0; j < count; j++) {
+            if (handlers[i] != labels[j].handler) continue;
+            table[i] = labels[j].label;
+            break;
+        }
+    }
+    return table;
+}
@@ -39,6 +39,31 @@ Csnd::~Csnd() {
         delete[] csndBuffer[i];
 }
 
+void Csnd::serialize(SaveState &s) {
+    // Transfer the channel and codec state, leaving host audio buffers alone
+    s.io(dspClock);
+    s.io(adpcmIndices);
+    s.io(adpcmSamples);
+    s.io(adpcmToggle);
+    s.io(enabled);
+    s.io(dutyCycles);
+    s.io(noiseValues);
+    s.io(chanCurrent);
+    s.io(chanTimers);
+    s.io(csndMainVol);
+    s.io(csndMainCnt);
+    s.io(csndChanCnt);
+    s.io(csndChanRate);
+    s.io(csndChanRvol);
+    s.io(csndChanLvol);
+    s.io(csndChanStart);
+    s.io(csndChanSize);
+    s.io(csndChanLoop);
+    s.io(csndAdpcmStart);
+    s.io(csndAdpcmLoop);
+    s.io(codecSndexcnt);
+}
+
 uint32_t *Csnd::getSamples(uint32_t freq, uint32_t count) {
     // Check if parameters changed and update the buffer details if so
     dspSize = count * ((dspClock == CLK_33KHZ) ? 32728 : 47605) / freq;
@@ -221,8 +246,8 @@ void Csnd::sampleCsnd(int16_t left, int16_t right) {
     csndBuffer[0][csndOfs++] = (right << 16) | (left & 0xFFFF);
     if (csndOfs != csndSize) return;
 
-    // Limit FPS to 60 if enabled by waiting for the previous buffer to play
-    if (Settings::fpsLimiter) {
+    // Limit FPS to 60 if enabled and not in turbo mode by waiting for the previous buffer to play
+    if (Settings::fpsLimiter && !Settings::turboMode) {
         std::unique_lock<std::mutex> lock(mutexes[0]);
         condVars[0].wait_for(lock, std::chrono::microseconds(1000000), [&]{ return !ready.load(); });
     }
@@ -26,6 +26,7 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 enum DspClock {
     CLK_OFF,
@@ -37,6 +38,7 @@ class Csnd {
 public:
     Csnd(Core &core): core(core) {}
     ~Csnd();
+    void serialize(SaveState &s);
 
     uint32_t *getSamples(uint32_t freq, uint32_t count);
     void runSample();
@@ -22,12 +22,14 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class Dsp {
 public:
     virtual ~Dsp() {}
     virtual void resetCycles() = 0;
     virtual void setAudClock(DspClock clock) = 0;
+    virtual void serialize(SaveState &s) = 0;
 
     virtual uint16_t readPdata() = 0;
     virtual uint16_t readPcfg() = 0;
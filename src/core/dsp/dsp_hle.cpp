@@ -52,11 +52,32 @@ void DspHle::setAudClock(DspClock clock) {
         return;
     }
 
-    // Set the frame event frequency and schedule it if newly enabled
+    // Set the frame event frequency and schedule it if newly enabled, leaving a pending update at its time
     cycles = ((clock == CLK_33KHZ) ? 8192 : 5632) * 8 * 20;
-    if (scheduled || state != STATE_RUNNING) return;
+    if (state != STATE_RUNNING || core.isPending(DSP_HLE_UPDATE)) return;
     core.schedule(DSP_HLE_UPDATE, cycles);
-    scheduled = true;
+}
+
+void DspHle::serialize(SaveState &s) {
+    // Transfer the DSP interface registers
+    s.io(dspPadr);
+    s.io(dspPcfg);
+    s.io(dspPsts);
+    s.io(dspPsem);
+    s.io(dspPmask);
+    s.io(dspSem);
+    s.io(dspCmd);
+    s.io(dspRep);
+
+    // Transfer the HLE state machine and audio inputs
+    s.io(readFifo);
+    s.io(cycles);
+    s.io(state);
+    s.io(inputs);
+    s.io(outVolume);
+    s.io(frameBase);
+    s.io(saveAddress);
+    s.io(canRestore);
 }
 
 void DspHle::update() {
@@ -70,7 +91,6 @@ void DspHle::update() {
 
         // Wait for the response to be read
         state = STATE_INIT0;
-        scheduled = false;
         return;
 
     case STATE_INIT1:
@@ -94,7 +114,6 @@ void DspHle::update() {
 
         // Wait for the pipe 2 input command
         state = STATE_RECEIVE0;
-        scheduled = false;
         return;
 
     case STATE_RECEIVE1:
@@ -118,7 +137,6 @@ void DspHle::update() {
 
         // Wait for the response to be read
         state = STATE_REPLY0;
-        scheduled = false;
         return;
 
     case STATE_REPLY1:
@@ -159,8 +177,6 @@ void DspHle::update() {
         // Schedule the next frame event if enabled
         if (cycles)
             core.schedule(DSP_HLE_UPDATE, cycles);
-        else
-            scheduled = false;
         return;
 
     case STATE_INTERRUPT:
@@ -170,7 +186,6 @@ void DspHle::update() {
 
         // Wait for the response to be read
         state = STATE_RESET0;
-        scheduled = false;
         return;
 
     case STATE_RESET1:
@@ -193,23 +208,20 @@ void DspHle::update() {
 
         // Wait for the final reset command
         state = STATE_STOPPED0;
-        scheduled = false;
         return;
 
     case STATE_STOPPED1:
         // Send a final reply and stop running
         sendResponse(2, 0x8000);
-        scheduled = false;
         return;
     }
 }
 
 void DspHle::advanceState() {
-    // Advance to the next DSP state and schedule an update
+    // Advance to the next DSP state and schedule an update, leaving a pending one at its time
     state = DspState(state + 1);
-    if (scheduled) return;
-    core.schedule(DSP_HLE_UPDATE, 10000);
-    scheduled = true;
+    if (!core.isPending(DSP_HLE_UPDATE))
+        core.schedule(DSP_HLE_UPDATE, 10000);
 }
 
 void DspHle::processFrame() {
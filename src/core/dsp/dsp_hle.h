@@ -71,6 +71,7 @@ public:
 
     void resetCycles() {}
     void setAudClock(DspClock clock);
+    void serialize(SaveState &s);
 
     uint16_t readPdata();
     uint16_t readPcfg() { return dspPcfg; }
@@ -94,7 +95,6 @@ private:
 
     std::queue<uint16_t> readFifo;
     uint32_t cycles = 0;
-    bool scheduled = false;
 
     DspState state = STATE_OFF;
     InputState inputs[24] = {};
@@ -34,11 +34,68 @@ void DspLle::setAudClock(DspClock clock) {
         return;
     }
 
-    // Set the audio FIFO event frequency and schedule it if newly enabled
+    // Set the audio FIFO event frequency and schedule it if newly enabled, leaving a pending event at its time
     audCycles = ((clock == CLK_33KHZ) ? 8192 : 5632) * 8;
-    if (audScheduled || !audOutEnable) return;
+    if (!audOutEnable || core.isPending(DSP_SEND_AUDIO)) return;
     core.schedule(DSP_SEND_AUDIO, audCycles);
-    audScheduled = true;
+}
+
+void DspLle::serialize(SaveState &s) {
+    // Transfer the DSP interface registers and the Teak CPU
+    s.io(dspPadr);
+    s.io(dspPcfg);
+    s.io(dspPsts);
+    s.io(dspPsem);
+    s.io(dspPmask);
+    s.io(dspSem);
+    s.io(dspCmd);
+    s.io(dspRep);
+    teak.serialize(s);
+
+    // Transfer the Teak peripheral state
+    s.io(audOutFifo);
+    s.io(readFifo);
+    s.io(readLength);
+    s.io(tmrCycles);
+    s.io(tmrLatches);
+    s.io(tmrSignals);
+    s.io(miuBoundX);
+    s.io(miuBoundY);
+    s.io(dmaSignals);
+    s.io(icuState);
+    s.io(audCycles);
+    s.io(tmrCtrl);
+    s.io(tmrReload);
+    s.io(tmrCount);
+    s.io(hpiMask);
+    s.io(hpiCfg);
+    s.io(hpiSts);
+    s.io(miuPageX);
+    s.io(miuPageY);
+    s.io(miuPageZ);
+    s.io(miuSize0);
+    s.io(miuMisc);
+    s.io(miuIoBase);
+    s.io(dmaStart);
+    s.io(dmaEnd);
+    s.io(dmaSelect);
+    s.io(dmaSrcAddr);
+    s.io(dmaDstAddr);
+    s.io(dmaSize);
+    s.io(dmaSrcStep);
+    s.io(dmaDstStep);
+    s.io(dmaAreaCfg);
+    s.io(dmaCtrl);
+    s.io(icuPending);
+    s.io(icuTrigger);
+    s.io(icuEnable);
+    s.io(icuMode);
+    s.io(icuVector);
+    s.io(icuDisable);
+    s.io(audOutCtrl);
+    s.io(audOutEnable);
+    s.io(audOutStatus);
+    s.io(audOutFlush);
 }
 
 uint32_t DspLle::getMiuAddr(uint16_t address) {
@@ -59,6 +116,7 @@ uint16_t DspLle::readData(uint16_t address) {
         return core.memory.read<uint16_t>(ARM11, getMiuAddr(address));
 
     // Read a value from a DSP I/O register
+    CoreLock lock(core);
     switch (address - miuIoBase) {
         case 0x01A: return 0xC902; // Chip ID
         case 0x020: return tmrCtrl[0];
@@ -168,6 +226,7 @@ void DspLle::writeData(uint16_t address, uint16_t value) {
         return core.memory.write<uint16_t>(ARM11, getMiuAddr(address), value);
 
     // Write a value to a DSP I/O register
+    CoreLock lock(core);
     switch (address - miuIoBase) {
         case 0x020: return writeTmrCtrl(0, value);
         case 0x022: return writeTmrEvent(0, value);
@@ -260,10 +319,6 @@ void DspLle::writeData(uint16_t address, uint16_t value) {
 }
 
 void DspLle::underflowTmr(int i) {
-    // Ensure underflow should still occur at the current timestamp
-    if (tmrCycles[i] != core.globalCycles)
-        return;
-
     // Set a timer's signal and schedule a clear if enabled
     tmrSignals[i] = true;
     updateIcuState();
@@ -299,7 +354,7 @@ void DspLle::scheduleTmr(int i) {
     // Unschedule the timer if stopped, using external clock, or in event mode
     if ((tmrCtrl[i] & 0x1100) || !tmrCount[i] || ((tmrCtrl[i] >> 2) & 0x7) == 0x3) {
         tmrCycles[i] = -1;
-        return;
+        return core.cancel(Task(DSP_UNDERFLOW0 + i));
     }
 
     // Schedule a timer underflow using its current counter and prescaler
@@ -307,7 +362,7 @@ void DspLle::scheduleTmr(int i) {
     shift += 1 + (shift == 3);
     tmrCycles[i] = (uint64_t(tmrCount[i]) + 1) << shift;
     if (i) tmrCycles[i] = (tmrCycles[i] * 5) / 4; // 1.25x slower
-    core.schedule(Task(DSP_UNDERFLOW0 + i), tmrCycles[i]);
+    core.reschedule(Task(DSP_UNDERFLOW0 + i), tmrCycles[i]);
     tmrCycles[i] += core.globalCycles;
 }
 
@@ -327,10 +382,7 @@ void DspLle::flushAudOut() {
 
 void DspLle::sendAudio() {
     // Ignore and unschedule the audio FIFO event if stopped
-    if (!audOutEnable || !audCycles) {
-        audScheduled = false;
-        return;
-    }
+    if (!audOutEnable || !audCycles) return;
 
     // Flush the audio output FIFO and reschedule the event
     flushAudOut();
@@ -751,10 +803,9 @@ void DspLle::writeAudOutEnable(uint16_t value) {
     // Write to the audio output enable register
     audOutEnable = (value & 0x8000);
 
-    // Schedule the audio FIFO event at the current frequency if newly enabled
-    if (audScheduled || !audOutEnable || !audCycles) return;
+    // Schedule the audio FIFO event at the current frequency if newly enabled, leaving a pending event at its time
+    if (!audOutEnable || !audCycles || core.isPending(DSP_SEND_AUDIO)) return;
     core.schedule(DSP_SEND_AUDIO, audCycles);
-    audScheduled = true;
 }
 
 void DspLle::writeAudOutFifo(uint16_t value) {
@@ -828,7 +879,8 @@ void DspLle::writePcfg(uint16_t mask, uint16_t value) {
 
     // Reset LLE DSP if the backend is unchanged
     LOG_INFO("Restarting LLE DSP execution\n");
-    teak.cycles = teak.regPc = 0;
+    if (!teak.sendMail(BIT(15)))
+        teak.cycles = teak.regPc = 0;
 }
 
 void DspLle::writePsem(uint16_t mask, uint16_t value) {
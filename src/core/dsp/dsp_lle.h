@@ -33,6 +33,7 @@ public:
     DspLle(Core &core): core(core), teak(core, *this) {}
     void resetCycles();
     void setAudClock(DspClock clock);
+    void serialize(SaveState &s);
 
     uint16_t readData(uint16_t address);
     void writeData(uint16_t address, uint16_t value);
@@ -75,7 +76,6 @@ private:
     bool dmaSignals[3] = {};
     uint16_t icuState = 0;
     uint32_t audCycles = 0;
-    bool audScheduled = false;
 
     uint16_t tmrCtrl[2] = {};
     uint32_t tmrReload[2] = {};
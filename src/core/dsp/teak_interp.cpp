@@ -17,7 +17,14 @@
     along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "teak_interp_ops.h"
 #include "../core.h"
+#include "../dispatch.h"
+
+#if COMPUTED_GOTO
+template void TeakInterp::runDispatch<false>(uint64_t&);
+template void TeakInterp::runDispatch<true>(uint64_t&);
+#endif
 
 template void TeakInterp::multiplyXY<int16_t, int16_t>(int);
 template void TeakInterp::multiplyXY<int16_t, uint16_t>(int);
@@ -70,6 +77,65 @@ TeakInterp::TeakInterp(Core &core, DspLle &dsp): core(core), dsp(dsp) {
         initLookup();
 }
 
+void TeakInterp::serialize(SaveState &s) {
+    // Transfer the execution state and address unit settings
+    s.io(cycles);
+    s.io(regPc);
+    s.io(halted);
+    s.io(modMasks);
+    s.io(dmod);
+    s.io(arRn);
+    s.io(arpRi);
+    s.io(arpRj);
+    s.io(arCs);
+    s.io(arpCi);
+    s.io(arpCj);
+    s.io(arPm);
+    s.io(arpPi);
+    s.io(arpPj);
+
+    // Transfer the main registers
+    s.io(regA);
+    s.io(regB);
+    s.io(regP);
+    s.io(regX);
+    s.io(regY);
+    s.io(regR);
+    s.io(regExt);
+    s.io(regSp);
+    s.io(regSv);
+    s.io(regMixp);
+    s.io(regLc);
+    s.io(regRepc);
+    s.io(regIcr);
+    s.io(regSt);
+    s.io(regStt);
+    s.io(regMod);
+    s.io(regCfg);
+    s.io(regStep0);
+    s.io(regAr);
+    s.io(regArp);
+
+    // Transfer the shadow registers and block repeat stack
+    s.io(shiftP);
+    s.io(shadA);
+    s.io(shadR);
+    s.io(shadRepc);
+    s.io(shadStt);
+    s.io(shadMod);
+    s.io(shadCfg);
+    s.io(shadStep0);
+    s.io(shadAr);
+    s.io(shadArp);
+    s.io(bkStack);
+    s.io(bkStart);
+    s.io(bkEnd);
+    s.io(repAddr);
+
+    // Drop any mail left over from a threaded run
+    if (s.loading) mail.store(0);
+}
+
 void TeakInterp::resetCycles() {
     // Adjust CPU cycles for a global cycle reset
     if (cycles != -1)
@@ -82,6 +148,60 @@ void TeakInterp::stopCycles() {
     halted = true;
 }
 
+void TeakInterp::runSlice(uint64_t start, uint64_t &end) {
+    // Run instructions until the end of the slice, tracking shared time so tasks are scheduled correctly
+    cycles = std::max(cycles, start);
+#if COMPUTED_GOTO
+    runDispatch<true>(end);
+#else
+    while (cycles < end) {
+        core.globalCycles = cycles;
+        cycles += (runOpcode() << 1);
+        end = std::min(end, core.nextEvent.load(std::memory_order_relaxed));
+    }
+#endif
+}
+
+void TeakInterp::runSliceThreaded(uint64_t start, uint64_t end) {
+    // Run instructions until the end of the slice or the next scheduled task, picking up mail from other threads
+    checkMail();
+    cycles = std::max(cycles, start);
+#if COMPUTED_GOTO
+    runDispatch<false>(end);
+#else
+    while (cycles < end) {
+        if (mail.load(std::memory_order_relaxed))
+            checkMail();
+        cycles += (runOpcode() << 1);
+        end = std::min(end, core.nextEvent.load(std::memory_order_relaxed));
+    }
+#endif
+}
+
+bool TeakInterp::sendMail(uint16_t bits) {
+    // Post signals for the Teak thread if it's running on a different one
+    if (threadId == std::thread::id() || threadId == std::this_thread::get_id())
+        return false;
+    mail.fetch_or(bits);
+    return true;
+}
+
+void TeakInterp::checkMail() {
+    // Reset the Teak if requested by another thread
+    uint16_t bits = mail.exchange(0);
+    if (!bits) return;
+    if (bits & BIT(15)) {
+        cycles = core.globalCycles;
+        regPc = 0;
+    }
+
+    // Set interrupts that were requested by another thread
+    if (bits & 0xF) {
+        CoreLock lock(core);
+        setPendingIrqs(bits & 0xF);
+    }
+}
+
 void TeakInterp::incrementPc() {
     // Increment the program counter and check if it's at the end of a loop
     regPc = (regPc + 1) & 0x1FFFF;
@@ -99,7 +219,7 @@ void TeakInterp::incrementPc() {
     }
 }
 
-int TeakInterp::runOpcode() {
+FORCE_INLINE uint16_t TeakInterp::fetchOpcode() {
     // Reset the program counter and decrement the repeat counter if repeating
     if (repAddr != -1) {
         regPc = repAddr;
@@ -109,12 +229,63 @@ int TeakInterp::runOpcode() {
         }
     }
 
-    // Look up an instruction to execute and increment the program counter
+    // Read an instruction to execute, count it, and increment the program counter
+    instructions++;
     uint16_t opcode = core.memory.read<uint16_t>(ARM11, 0x1FF00000 + (regPc << 1));
     incrementPc();
-    return (this->*teakInstrs[opcode])(opcode);
+    return opcode;
 }
 
+int TeakInterp::runOpcode() {
+    // Look up an instruction and execute it
+    uint16_t opcode = fetchOpcode();
+    return COUNT_OP(teakStats[opcode], opcode, (this->*teakInstrs[opcode])(opcode));
+}
+
+#if COMPUTED_GOTO
+// Pair each listed handler with its label in the dispatch loop
+#define TEAK_LABEL(name) { &TeakInterp::name, &&TEAK_##name },
+
+// Define a label that runs a handler directly, then dispatches the next instruction
+#define TEAK_HANDLER(name) TEAK_##name: cycles += (COUNT_OP(teakStats[opcode], opcode, name(opcode)) << 1); TEAK_DISPATCH()
+
+// Check the end of the slice, then fetch an instruction and jump to its handler like in runOpcode
+// This is expanded after every handler, giving each its own indirect branch for the host to predict
+#define TEAK_DISPATCH() \
+    end = std::min(end, core.nextEvent.load(std::memory_order_relaxed)); \
+    if (cycles >= end) return; \
+    if (shared) core.globalCycles = cycles; \
+    else if (mail.load(std::memory_order_relaxed)) checkMail(); \
+    opcode = fetchOpcode(); \
+    goto *teakLabels[opcode];
+
+template <bool shared> void TeakInterp::runDispatch(uint64_t &end) {
+    // Map the lookup table to handler labels once, since the table remains the source of truth
+    static const OpLabel<int (TeakInterp::*)(uint16_t)> teakOps[] = { TEAK_OPS(TEAK_LABEL) };
+    static void **teakLabels = mapLabels(teakInstrs, 0x10000, teakOps, sizeof(teakOps) / sizeof(*teakOps), &&teakTable);
+
+    // Run instructions until the end of the slice, threading from handler to handler
+    // Shared time and the task queue are only updated when not running on a separate thread
+    uint16_t opcode;
+    TEAK_DISPATCH()
+    TEAK_OPS(TEAK_HANDLER)
+
+    // Handle instructions with unlisted handlers
+teakTable:
+    cycles += (COUNT_OP(teakStats[opcode], opcode, (this->*teakInstrs[opcode])(opcode)) << 1);
+    TEAK_DISPATCH()
+}
+#endif
+
+#if OP_STATS
+void TeakInterp::writeOpStats(FILE *file, const char *name) {
+    // Write a report of the Teak handlers that were executed, sorted by cycles
+    std::vector<OpGroup> groups;
+    groupOps(groups, "teakInstrs", teakStats, teakInstrs, 0x10000);
+    writeOps(file, name, groups);
+}
+#endif
+
 uint16_t TeakInterp::readParam() {
     // Read an additional parameter word and increment the program counter
     uint16_t param = core.memory.read<uint16_t>(ARM11, 0x1FF00000 + (regPc << 1));
@@ -123,23 +294,26 @@ uint16_t TeakInterp::readParam() {
 }
 
 void TeakInterp::setPendingIrqs(uint8_t mask) {
+    // Defer to the Teak thread if called from elsewhere
+    if (sendMail(mask)) return;
+
     // Set interrupt pending bits in the status registers
     regStt[2] |= (mask & 0xF);
     regSt[2] |= ((mask & 0x4) << 11) | ((mask & 0x3) << 14);
 
     // Schedule an interrupt if one is enabled and pending
-    if (!(regMod[3] & BIT(7)) || scheduled) return;
+    if (!(regMod[3] & BIT(7))) return;
+    for (int i = 0; i < 4; i++)
+        if (core.isPending(Task(TEAK_INTERRUPT0 + i))) return;
     for (int i = 0; i < 4; i++) {
         if (!(regStt[2] & (regMod[3] >> 8) & BIT(i))) continue;
         core.schedule(Task(TEAK_INTERRUPT0 + i), 2);
-        scheduled = true;
         return;
     }
 }
 
 void TeakInterp::interrupt(int i) {
     // Ensure the interrupt condition still holds
-    scheduled = false;
     if (!(regMod[3] & BIT(7)) || !(regStt[2] & (regMod[3] >> 8) & BIT(i))) return;
 
     // Resume execution after an idle loop
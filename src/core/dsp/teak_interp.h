@@ -19,9 +19,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <thread>
+#include "../op_stats.h"
 
 class Core;
+class SaveState;
 class DspLle;
 
 enum StepType {
@@ -49,19 +53,33 @@ public:
     uint64_t cycles = -1;
     uint32_t regPc = 0;
     bool halted = false;
+    uint64_t instructions = 0;
+    std::thread::id threadId;
 
     TeakInterp(Core &core, DspLle &dsp);
     void resetCycles();
     void stopCycles();
+    void serialize(SaveState &s);
 
     int runOpcode();
+    void runSlice(uint64_t start, uint64_t &end);
+    void runSliceThreaded(uint64_t start, uint64_t end);
+#if COMPUTED_GOTO
+    template <bool shared> void runDispatch(uint64_t &end);
+#endif
+    bool sendMail(uint16_t bits);
+    void checkMail();
     void setPendingIrqs(uint8_t mask);
     void interrupt(int i);
 
+#if OP_STATS
+    void writeOpStats(FILE *file, const char *name);
+#endif
+
 private:
     Core &core;
     DspLle &dsp;
-    bool scheduled = false;
+    std::atomic<uint16_t> mail{0};
 
     uint16_t *readReg[0x20] = { &regR[0], &regR[1], &regR[2], &regR[3], &regR[4], &regR[5], &regR[7],
         &regY[0], &regSt[0], &regSt[1], &regSt[2], &shiftP[0].h, (uint16_t*)&regPc, &regSp, &regCfg[0],
@@ -155,6 +173,11 @@ private:
     uint32_t bkEnd[4] = {};
     uint32_t repAddr = -1;
 
+#if OP_STATS
+    OpStat teakStats[0x10000] = {};
+#endif
+
+    uint16_t fetchOpcode();
     void incrementPc();
     uint16_t readParam();
 
@@ -108,8 +108,10 @@ int TeakInterp::br(uint16_t opcode) { // BR Address18, Cond
 
 int TeakInterp::brr(uint16_t opcode) { // BRR RelAddr7, Cond
     // Catch idle loops and halt instead of executing them
-    if (opcode == 0x57F0)
-        core.schedule(TEAK_STOP_CYCLES, 0);
+    if (opcode == 0x57F0) {
+        CoreLock lock(core);
+        core.scheduleOnce(TEAK_STOP_CYCLES, 0);
+    }
 
     // Branch to a relative 7-bit signed offset if the condition is met
     if (checkCond(opcode))
@@ -0,0 +1,62 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Teak handlers that get their own dispatch labels when built with computed goto
+// Handlers missing from this list still work, but dispatch through the lookup table
+#define TEAK_OPS(X) \
+    X(addAbb) X(addBa) X(addI16a) X(addI8a) X(addMi16a) X(addMi8a) X(addM7i16a) X(addM7i7a) X(addMrna) X(addPb) \
+    X(addP1a) X(addPpab) X(addRega) X(addR6a) X(addhMi8) X(addhMrn) X(addhReg) X(addhR6) X(addlMi8) X(addlMrn) \
+    X(addlReg) X(addlR6) X(addvMi8) X(addvMrn) X(addvReg) X(addvR6) X(adda) X(add3) X(add3a) X(add3aa) X(andAbab) \
+    X(andI16) X(andI8) X(andMi16) X(andMi8) X(andM7i16) X(andM7i7) X(andMrn) X(andReg) X(andR6) X(banke) X(bkrepI8) \
+    X(bkrepReg) X(bkrepR6) X(bkreprstMrar) X(bkreprstMsp) X(bkrepstoMrar) X(bkrepstoMsp) X(_break) X(br) X(brr) \
+    X(call) X(callaA) X(callaAl) X(callr) X(chngMi8) X(chngMrn) X(chngReg) X(chngR6) X(chngSm) X(clrA) X(clrB) \
+    X(clrp0) X(clrp1) X(clrp01) X(clrrA) X(clrrB) X(cmpAb) X(cmpBa) X(cmpB0b1) X(cmpB1b0) X(cmpI16a) X(cmpI8a) \
+    X(cmpMi16a) X(cmpMi8a) X(cmpM7i16a) X(cmpM7i7a) X(cmpMrna) X(cmpRega) X(cmpR6a) X(cmpuMi8) X(cmpuMrn) X(cmpuReg) \
+    X(cmpuR6) X(cmpvMi8) X(cmpvMrn) X(cmpvReg) X(cmpvR6) X(cntxR) X(cntxS) X(copy) X(dec) X(dint) X(eint) X(exchIj) \
+    X(exchJi) X(expB) X(expBa) X(expMrn) X(expMrna) X(expReg) X(expRega) X(expR6) X(expR6a) X(inc) X(limA0) X(limA1) \
+    X(limA0a1) X(limA1a0) X(loadMod) X(loadMpd) X(loadPage) X(loadPs) X(loadPs01) X(loadStep) X(maaMrmr) X(maaMrni16) \
+    X(maaY0mi8) X(maaY0mrn) X(maaY0reg) X(maaY0r6) X(maasuMrmr) X(maasuMrni16) X(maasuY0mrn) X(maasuY0reg) \
+    X(maasuY0r6) X(macMrmr) X(macMrni16) X(macY0mi8) X(macY0mrn) X(macY0reg) X(macY0r6) X(macsuMrmr) X(macsuMrni16) \
+    X(macsuY0mi8) X(macsuY0mrn) X(macsuY0reg) X(macsuY0r6) X(macusMrmr) X(macusMrni16) X(macusY0mrn) X(macusY0reg) \
+    X(macusY0r6) X(macuuMrmr) X(macuuMrni16) X(macuuY0mrn) X(macuuY0reg) X(macuuY0r6) X(maxGe) X(maxGt) X(minLe) \
+    X(minLt) X(mma) X(mmaa) X(mma3) X(mma3a) X(mmsua3) X(mmusa3) X(mmsua3a) X(mmusa3a) X(msumsua3a) X(msumusa3a) \
+    X(msumsua3aa) X(msumusa3aa) X(mma3Y) X(mma3aY) X(mmsua3Y) X(mmusa3Y) X(mmsua3aY) X(mmusa3aY) X(modrD2) X(modrD2d) \
+    X(modrI2) X(modrI2d) X(modrZids) X(modrZidsd) X(modrMrmr) X(modrMrmrd) X(modrMrdmr) X(modrMrdmrd) X(movApc) \
+    X(movA0hstp) X(movAbab) X(movAbp0) X(movAblhmi8) X(movAblarap) X(movAblsm) X(movAblx1) X(movAbly1) X(movAlmi16) \
+    X(movAlm7i16) X(movAlm7i7) X(movArapabl) X(movI16arap) X(movI16b) X(movI16reg) X(movI16r6) X(movI16sm) \
+    X(movI16stp) X(movI8al) X(movI8ry) X(movI8sv) X(movMi16a) X(movMi8ab) X(movMi8ablh) X(movMi8ry) X(movMi8sv) \
+    X(movM7i16a) X(movM7i7a) X(movMrnb) X(movMrnreg) X(movMxpreg) X(movPrar) X(movPrars) X(movP1ab) X(movRarp) \
+    X(movRegb) X(movR6mrn) X(movMrnr6) X(movRegmrn) X(movRegmxp) X(movP0a) X(unkOp) X(movRegreg) X(movRegr6) \
+    X(movRymi8) X(movR6reg) X(movSmabl) X(movStpa0h) X(movSvmi8) X(movaAbrar) X(movaRarab) X(movpPmareg) X(movpdw) \
+    X(mov2Abhabh) X(movsMi8ab) X(movsMrnab) X(movsRegab) X(movsR6a) X(movsi) X(mpyY0mi8) X(mpyY0mrn) X(mpyY0reg) \
+    X(mpyY0r6) X(mpyi) X(mpysuMrmr) X(mpysuY0mrn) X(mpysuY0reg) X(mpysuY0r6) X(msuMrmr) X(msuMrni16) X(msuY0mi8) \
+    X(msuY0mrn) X(msuY0reg) X(msuY0r6) X(neg) X(nop) X(_not) X(orAba) X(orAb) X(orBb) X(orI16) X(orI8) X(orMi16) \
+    X(orMi8) X(orM7i16) X(orM7i7) X(orMrn) X(orReg) X(orR6) X(popAbe) X(popArsm) X(popB) X(popP) X(popReg) X(popRepc) \
+    X(popR6) X(popX) X(popY1) X(popaAb) X(pushAbe) X(pushArsm) X(pushI16) X(pushP) X(pushReg) X(pushRpc) X(pushR6) \
+    X(pushX) X(pushY1) X(pushaA) X(pushaB) X(repI8) X(repReg) X(repR6) X(ret) X(reti) X(rets) X(rnd) X(rstMi8) \
+    X(rstMrn) X(rstReg) X(rstR6) X(rstSm) X(setMi8) X(setMrn) X(setReg) X(setR6) X(setSm) X(shfc) X(shfi) X(shlA) \
+    X(shlB) X(shl4A) X(shl4B) X(shrA) X(shrB) X(shr4A) X(shr4B) X(sqrMi8) X(sqrMrn) X(sqrReg) X(sqrR6) X(subAbb) \
+    X(subBa) X(subI16a) X(subI8a) X(subMi16a) X(subMi8a) X(subM7i16a) X(subM7i7a) X(subMrna) X(subRega) X(subR6a) \
+    X(subhMi8) X(subhMrn) X(subhReg) X(subhR6) X(sublMi8) X(sublMrn) X(sublReg) X(sublR6) X(swap) X(tstbMi8) \
+    X(tstbMrn) X(tstbR6) X(tstbReg) X(tstbSm) X(tst0Almi8) X(tst0Almrn) X(tst0Alreg) X(tst0Alr6) X(tst0I16mi8) \
+    X(tst0I16mrn) X(tst0I16reg) X(tst0I16r6) X(tst0I16sm) X(tst1Almi8) X(tst1Almrn) X(tst1Alreg) X(tst1Alr6) \
+    X(tst1I16mi8) X(tst1I16mrn) X(tst1I16reg) X(tst1I16r6) X(tst1I16sm) X(xorI16) X(xorI8) X(xorMi16) X(xorMi8) \
+    X(xorM7i16) X(xorM7i7) X(xorMrn) X(xorReg) X(xorR6)
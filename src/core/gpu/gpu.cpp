@@ -18,9 +18,11 @@
 */
 
 #include "../core.h"
-#include "gpu_render_ogl.h"
 #include "gpu_render_soft.h"
+#ifndef NO_OPENGL
+#include "gpu_render_ogl.h"
 #include "gpu_shader_glsl.h"
+#endif
 
 const int16_t GpuRender::etc1Tables[][4] {
     { 2, 8, -2, -8 },
@@ -45,6 +47,12 @@ Gpu::~Gpu() {
 }
 
 void Gpu::createRender() {
+#ifdef NO_OPENGL
+    // Always use the software renderer and shader in builds without OpenGL
+    renderType = shaderType = 0;
+    gpuRender = new GpuRenderSoft(core);
+    gpuShader = new GpuShaderInterp(*gpuRender, shdInput);
+#else
     // Initialize a new renderer of the current type
     if (Settings::gpuRenderer == 1) (*contextFunc)();
     switch (renderType = Settings::gpuRenderer) {
@@ -58,6 +66,7 @@ void Gpu::createRender() {
         case 1: gpuShader = new GpuShaderGlsl(*(GpuRenderOgl*)gpuRender, shdInput); break;
     }
     if (renderType == 1) (*contextFunc)();
+#endif
 }
 
 void Gpu::destroyRender() {
@@ -67,7 +76,7 @@ void Gpu::destroyRender() {
     if (renderType == 1) (*contextFunc)();
 }
 
-void Gpu::syncRender() {
+void Gpu::syncRender(bool reset) {
     // Stop the GPU thread or release context on this thread depending on settings
     if (running.exchange(false)) {
         if (thread) {
@@ -80,8 +89,8 @@ void Gpu::syncRender() {
         }
     }
 
-    // Reset the renderer if it was changed
-    if (renderType == Settings::gpuRenderer && shaderType == Settings::gpuShader) return;
+    // Reset the renderer if it was changed or a reset was requested
+    if (!reset && renderType == Settings::gpuRenderer && shaderType == Settings::gpuShader) return;
     destroyRender();
     createRender();
 
@@ -294,6 +303,138 @@ void Gpu::syncRender() {
     if (renderType == 1) (*contextFunc)();
 }
 
+void Gpu::serialize(SaveState &s) {
+    // Finish any threaded rendering so registers and memory are settled
+    syncRender();
+
+    // Transfer the command list and vertex input state
+    s.io(cmdAddr);
+    s.io(cmdEnd);
+    s.io(curCmd);
+    s.io(fixedBase);
+    s.io(shdInput);
+    s.io(attrFixedData);
+    s.io(attrFixedIdx);
+
+    // Transfer the shader programs and uniforms
+    s.io(vshCode);
+    s.io(vshDesc);
+    s.io(vshFloats);
+    s.io(vshFloatData);
+    s.io(vshFloatIdx);
+    s.io(vshFloat32);
+    s.io(gshCode);
+    s.io(gshDesc);
+    s.io(gshFloats);
+    s.io(gshFloatData);
+    s.io(gshFloatIdx);
+    s.io(gshFloat32);
+
+    // Transfer the GPU registers
+    s.io(cfg11GpuCnt);
+    s.io(gpuFill);
+    s.io(gpuCopy);
+    s.io(gpuIrqCmp);
+    s.io(gpuIrqMask);
+    s.io(gpuIrqStat);
+    s.io(gpuIrqAutostop);
+    s.io(gpuIrqReq);
+    s.io(gpuFaceCulling);
+    s.io(gpuViewScaleH);
+    s.io(gpuViewStepH);
+    s.io(gpuViewScaleV);
+    s.io(gpuViewStepV);
+    s.io(gpuShdOutTotal);
+    s.io(gpuShdOutMap);
+    s.io(gpuViewXY);
+    s.io(gpuTexBorder);
+    s.io(gpuTexDim);
+    s.io(gpuTexParam);
+    s.io(gpuTexAddr1);
+    s.io(gpuTexType);
+    s.io(gpuCombSrc);
+    s.io(gpuCombOper);
+    s.io(gpuCombMode);
+    s.io(gpuCombColor);
+    s.io(gpuCombBufUpd);
+    s.io(gpuCombBufCol);
+    s.io(gpuBlendFunc);
+    s.io(gpuBlendColor);
+    s.io(gpuAlphaTest);
+    s.io(gpuStencilTest);
+    s.io(gpuStencilOp);
+    s.io(gpuDepcolMask);
+    s.io(gpuColbufWrite);
+    s.io(gpuDepbufWrite);
+    s.io(gpuDepbufFmt);
+    s.io(gpuColbufFmt);
+    s.io(gpuDepbufLoc);
+    s.io(gpuColbufLoc);
+    s.io(gpuBufferDim);
+    s.io(gpuLightSpec0);
+    s.io(gpuLightSpec1);
+    s.io(gpuLightDiff);
+    s.io(gpuLightAmb);
+    s.io(gpuLightVecL);
+    s.io(gpuLightVecH);
+    s.io(gpuLightSpotL);
+    s.io(gpuLightSpotH);
+    s.io(gpuLightConfig);
+    s.io(gpuLightAtnBias);
+    s.io(gpuLightAtnScl);
+    s.io(gpuLightBaseAmb);
+    s.io(gpuLightTotal);
+    s.io(gpuLightConfig0);
+    s.io(gpuLightConfig1);
+    s.io(gpuLightLutIdx);
+    s.io(gpuLightLutD0);
+    s.io(gpuLightLutD1);
+    s.io(gpuLightLutFr);
+    s.io(gpuLightLutRb);
+    s.io(gpuLightLutRg);
+    s.io(gpuLightLutRr);
+    s.io(gpuLightLutSp);
+    s.io(gpuLightLutDa);
+    s.io(gpuLightLutAbs);
+    s.io(gpuLightLutSel);
+    s.io(gpuLightLutScl);
+    s.io(gpuLightIds);
+    s.io(gpuAttrBase);
+    s.io(gpuAttrFmt);
+    s.io(gpuAttrOfs);
+    s.io(gpuAttrCfg);
+    s.io(gpuAttrIdxList);
+    s.io(gpuAttrNumVerts);
+    s.io(gpuGshConfig);
+    s.io(gpuAttrFirstIdx);
+    s.io(gpuCmdSize);
+    s.io(gpuCmdAddr);
+    s.io(gpuVshNumAttr);
+    s.io(gpuVshOutTotal);
+    s.io(gpuPrimConfig);
+    s.io(gpuPrimRestart);
+    s.io(gpuGshBools);
+    s.io(gpuGshInts);
+    s.io(gpuGshInputCfg);
+    s.io(gpuGshEntry);
+    s.io(gpuGshAttrIds);
+    s.io(gpuGshOutMask);
+    s.io(gpuGshCodeIdx);
+    s.io(gpuGshDescIdx);
+    s.io(gpuVshBools);
+    s.io(gpuVshInts);
+    s.io(gpuVshEntry);
+    s.io(gpuVshAttrIds);
+    s.io(gpuVshOutMask);
+    s.io(gpuVshCodeIdx);
+    s.io(gpuVshDescIdx);
+
+    // Recreate the renderer and shader from the loaded state
+    if (!s.loading) return;
+    fixedDirty = true;
+    syncRender(true);
+}
+
 void Gpu::addThreadTask(GpuTaskType type, void *data) {
     // Add a thread task to the queue
     uint16_t end = taskEnd.load();
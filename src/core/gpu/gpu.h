@@ -26,6 +26,7 @@
 
 class Core;
 class GpuRender;
+class SaveState;
 class GpuShader;
 
 enum PrimMode {
@@ -236,7 +237,8 @@ public:
     Gpu(Core &core, std::function<void()> *contextFunc);
     ~Gpu();
 
-    void syncRender();
+    void syncRender(bool reset = false);
+    void serialize(SaveState &s);
     void endFill(int i);
     void endCopy();
 
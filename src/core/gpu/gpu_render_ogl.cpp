@@ -681,8 +681,9 @@ void GpuRenderOgl::updateTextures() {
             glBindTexture(GL_TEXTURE_2D, cache->tex);
             const TexCache *c = cache;
 
-            // Verify memory tags and invalidate the cache if they changed
+            // Verify memory tags and invalidate the cache if they changed, watching the pages for writes
             for (int j = 0; j < c->size; j++) {
+                core.memory.watchPage(c->addr + (j << 12));
                 uint32_t tag = core.memory.memMap11[(c->addr >> 12) + j].tag;
                 if (c->tags[j] == tag) continue;
                 c->tags[j] = tag;
@@ -695,8 +696,10 @@ void GpuRenderOgl::updateTextures() {
             static const uint8_t nybs[] = { 8, 6, 4, 4, 4, 4, 4, 2, 2, 2, 1, 1, 1, 2, 1 };
             tex.size = (tex.width * tex.height * nybs[tex.fmt] / 2 + 0xFFF) >> 12;
             tex.tags = new uint32_t[tex.size];
-            for (int j = 0; j < tex.size; j++)
+            for (int j = 0; j < tex.size; j++) {
+                core.memory.watchPage(tex.addr + (j << 12));
                 tex.tags[j] = core.memory.memMap11[(tex.addr >> 12) + j].tag;
+            }
 
             // Bind the new texture and add it to the cache
             glGenTextures(1, &tex.tex);
@@ -20,6 +20,17 @@
 #include <cstring>
 #include "../core.h"
 
+void Pdc::serialize(SaveState &s) {
+    // Transfer the display registers
+    s.io(screenBases);
+    s.io(pdcFramebufLt0);
+    s.io(pdcFramebufLt1);
+    s.io(pdcFramebufFormat);
+    s.io(pdcInterruptType);
+    s.io(pdcFramebufSelAck);
+    s.io(pdcFramebufStep);
+}
+
 uint32_t *Pdc::getFrame() {
     // Get the next frame in the queue when one is ready
     if (!ready.load()) return nullptr;
@@ -117,8 +128,8 @@ void Pdc::drawFrame() {
         screenBases[i] = base;
     }
 
-    // Allow up to 2 framebuffers to be queued
-    if (buffers.size() == 2) return;
+    // Allow up to 2 framebuffers to be queued, and skip some frames in turbo mode
+    if (buffers.size() == 2 || skipFrame()) return;
     uint32_t *buffer = new uint32_t[400 * 480];
     memset(buffer, 0, 400 * 480 * sizeof(uint32_t));
 
@@ -133,6 +144,25 @@ void Pdc::drawFrame() {
     mutex.unlock();
 }
 
+bool Pdc::skipFrame() {
+    // Draw every frame when not in turbo mode
+    if (!Settings::turboMode)
+        return false;
+
+    // Draw every Nth frame if a fixed frame skip is set
+    if (Settings::frameSkip) {
+        if (++skipCount < (1 << std::min(Settings::frameSkip, 3))) return true;
+        skipCount = 0;
+        return false;
+    }
+
+    // Automatically draw at most 60 frames per second of host time, however fast emulation runs
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - lastDrawTime < std::chrono::microseconds(1000000 / 60)) return true;
+    lastDrawTime = now;
+    return false;
+}
+
 void Pdc::writeFramebufLt0(int i, uint32_t mask, uint32_t value) {
     // Write to a screen's PDC_FRAMEBUF_LT0 register
     mask &= 0xFFFFFFF0;
@@ -20,15 +20,18 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <queue>
 #include <mutex>
 
 class Core;
+class SaveState;
 
 class Pdc {
 public:
     Pdc(Core &core): core(core) {}
+    void serialize(SaveState &s);
     uint32_t *getFrame();
     void drawFrame();
 
@@ -53,6 +56,8 @@ private:
     std::atomic<bool> ready{false};
     std::mutex mutex;
     uint32_t screenBases[2] = {};
+    std::chrono::steady_clock::time_point lastDrawTime;
+    uint32_t skipCount = 0;
 
     uint32_t pdcFramebufLt0[2] = {};
     uint32_t pdcFramebufLt1[2] = {};
@@ -61,5 +66,6 @@ private:
     uint32_t pdcFramebufSelAck[2] = {};
     uint32_t pdcFramebufStep[2] = {};
 
+    bool skipFrame();
     void drawScreen(int i, uint32_t *buffer);
 };
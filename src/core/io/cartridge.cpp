@@ -25,6 +25,7 @@ const uint16_t Cartridge::ctrClocks[] = { 64, 80, 96, 128, 160, 256, 256, 256 };
 Cartridge::Cartridge(Core &core, std::string &cartPath): core(core) {
     // Open a cartridge file if a path was provided
     if (cartPath.empty() || !(cartFile = fopen(cartPath.c_str(), "rb"))) return;
+    this->cartPath = cartPath;
     if (Settings::cartAutoBoot) core.aes.autoBoot();
     cfg9CardPower &= ~BIT(0); // Inserted
 
@@ -98,6 +99,39 @@ Cartridge::~Cartridge() {
     if (saveData) delete[] saveData;
 }
 
+void Cartridge::serialize(SaveState &s) {
+    // Transfer the transfer state and registers, leaving the ROM and save files as they are
+    s.io(ctrFifo);
+    s.io(ctrMode);
+    s.io(ntrReply);
+    s.io(ctrReply);
+    s.io(ntrCount);
+    s.io(ctrReadCount);
+    s.io(ctrWriteCount);
+    s.io(spiCount);
+    s.io(spiTotal);
+    s.io(ctrAddress);
+    s.io(spiAddress);
+    s.io(spiCommand);
+    s.io(spiStatus);
+    s.io(cfg9CardPower);
+    s.io(ntrMcnt);
+    s.io(ntrRomcnt);
+    s.io(ntrCmd);
+    s.io(ctrCnt);
+    s.io(ctrBlkcnt);
+    s.io(ctrSeccnt);
+    s.io(ctrCmd);
+    s.io(spiFifoCnt);
+    s.io(spiFifoSelect);
+    s.io(spiFifoBlklen);
+    s.io(spiFifoIntMask);
+    s.io(spiFifoIntStat);
+
+    // Reload the ROM block cache on the next read
+    if (s.loading) cartBase = -1;
+}
+
 uint32_t Cartridge::readCart(uint32_t address) {
     // Handle overflow and CARD2 save reads
     if (address >= cartSize) return 0xFFFFFFFF;
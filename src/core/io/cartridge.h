@@ -24,6 +24,7 @@
 #include <string>
 
 class Core;
+class SaveState;
 
 enum ReplyCmd {
     REPLY_NONE = 0,
@@ -37,8 +38,12 @@ enum ReplyCmd {
 
 class Cartridge {
 public:
+    std::string cartPath;
+    uint64_t cartSize = 0;
+
     Cartridge(Core &core, std::string &cartPath);
     ~Cartridge();
+    void serialize(SaveState &s);
 
     void updateSave();
     void ntrWordReady();
@@ -80,7 +85,6 @@ private:
     static const uint16_t ctrClocks[8];
 
     FILE *cartFile = nullptr;
-    uint64_t cartSize = 0;
     uint32_t cartId1 = -1;
     uint32_t cartId2 = -1;
     uint8_t *saveData = nullptr;
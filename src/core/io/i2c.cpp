@@ -19,6 +19,18 @@
 
 #include "../core.h"
 
+void I2c::serialize(SaveState &s) {
+    // Transfer the I2C bus and MCU state
+    s.io(writeCount);
+    s.io(devAddr);
+    s.io(regAddr);
+    s.io(mcuInc);
+    s.io(i2cBusData);
+    s.io(i2cBusCnt);
+    s.io(mcuIrqFlags);
+    s.io(mcuIrqMask);
+}
+
 void I2c::mcuInterrupt(uint32_t mask) {
     // Set MCU interrupt flags and trigger if a set flag is enabled
     if ((mcuIrqFlags |= mask) & ~mcuIrqMask)
@@ -22,10 +22,12 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class I2c {
 public:
     I2c(Core &core): core(core) {}
+    void serialize(SaveState &s);
     void mcuInterrupt(uint32_t mask);
 
     uint8_t readBusData(int i) { return i2cBusData[i]; }
@@ -19,6 +19,19 @@
 
 #include "../core.h"
 
+void Input::serialize(SaveState &s) {
+    // Transfer the SPI state, leaving host-driven input alone
+    s.io(spiCount);
+    s.io(spiTotal);
+    s.io(spiIndex);
+    s.io(spiPage);
+    s.io(spiFifoCnt);
+    s.io(spiFifoSelect);
+    s.io(spiFifoBlklen);
+    s.io(spiFifoIntMask);
+    s.io(spiFifoIntStat);
+}
+
 void Input::pressKey(int key) {
     // Clear key bits to indicate presses
     if (key < 12)
@@ -22,10 +22,12 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class Input {
 public:
     Input(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     void pressKey(int key);
     void releaseKey(int key);
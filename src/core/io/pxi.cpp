@@ -17,105 +17,138 @@
     along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include "../core.h"
 
+void PxiFifo::serialize(SaveState &s) {
+    // Transfer the FIFO contents in order, rebasing the indices when loading
+    uint32_t count = size(), first = start();
+    s.io(count);
+    if (s.loading) {
+        count = std::min<uint32_t>(count, 16);
+        first = seen = 0;
+        head.store(0);
+        discard.store(0);
+        tail.store(count);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t value = data[(first + i) & 0xF].load();
+        s.io(value);
+        data[(first + i) & 0xF].store(value);
+    }
+}
+
+void Pxi::serialize(SaveState &s) {
+    // Transfer the PXI FIFOs and registers, in the layout they had as plain values
+    fifos[0].serialize(s);
+    fifos[1].serialize(s);
+    uint32_t sync[2] = { readSync(0), readSync(1) };
+    uint16_t cnt[2] = { readCnt(0), readCnt(1) };
+    s.io(sync);
+    s.io(cnt);
+    s.io(pxiRecv);
+    if (!s.loading) return;
+
+    // Split the registers back into the parts each side writes, since FIFO status is read from the FIFOs
+    for (int i = 0; i < 2; i++) {
+        syncData[i].store(sync[i]);
+        syncIrq[i].store(sync[i] >> 31);
+        pxiCnt[i].store(cnt[i] & 0xC404);
+    }
+}
+
+uint16_t Pxi::readCnt(bool arm9) {
+    // Combine this CPU's enable and error bits with the current FIFO status
+    return pxiCnt[arm9].load() | (fifos[arm9].empty() << 0) | (fifos[arm9].full() << 1) |
+        (fifos[!arm9].empty() << 8) | (fifos[!arm9].full() << 9);
+}
+
 uint32_t Pxi::readRecv(bool arm9) {
-    // Ensure the FIFO is enabled
-    if (~pxiCnt[arm9] & BIT(15))
+    // Apply a clear from the other CPU, then ensure the FIFO is enabled
+    std::unique_lock<std::mutex> lock = lockSide(arm9);
+    if (fifos[!arm9].cleared())
+        pxiRecv[arm9] = 0;
+    if (~pxiCnt[arm9].load() & BIT(15))
         return pxiRecv[arm9];
 
     // Report an error if the FIFO is empty
-    if (pxiCnt[arm9] & BIT(8)) {
-        pxiCnt[arm9] |= BIT(14);
+    uint32_t size = fifos[!arm9].size();
+    if (!size) {
+        pxiCnt[arm9].fetch_or(BIT(14));
         return pxiRecv[arm9];
     }
 
-    // Receive a value from the FIFO
-    pxiRecv[arm9] = fifos[!arm9].front();
-    fifos[!arm9].pop();
-
-    if (fifos[!arm9].empty()) {
-        // Set the empty bits if the FIFO is now empty
-        pxiCnt[arm9] |= BIT(8);
-        pxiCnt[!arm9] |= BIT(0);
-
-        // Send a send FIFO empty interrupt to the other CPU if enabled
-        if (pxiCnt[!arm9] & BIT(2))
-            core.interrupts.sendInterrupt(arm9 ? ARM11 : ARM9, arm9 ? 0x52 : 13);
-    }
-    else if (fifos[!arm9].size() == 15) {
-        // Clear the full bits if the FIFO is no longer full
-        pxiCnt[arm9] &= ~BIT(9);
-        pxiCnt[!arm9] &= ~BIT(1);
-    }
-    return pxiRecv[arm9];
+    // Receive a value from the FIFO, and send a send FIFO empty interrupt to the other CPU if now empty and enabled
+    uint32_t value = pxiRecv[arm9] = fifos[!arm9].pop();
+    if (lock) lock.unlock();
+    if (size == 1 && (pxiCnt[!arm9].load() & BIT(2)))
+        sendInterrupt(!arm9, arm9 ? 0x52 : 13);
+    return value;
 }
 
 void Pxi::writeSync(bool arm9, uint32_t mask, uint32_t value)
 {
     // Send 8 bits to the other CPU if data is written
     if (mask & 0xFF00)
-        pxiSync[!arm9] = (pxiSync[!arm9] & ~0xFF) | ((value >> 8) & 0xFF);
+        syncData[!arm9].store(value >> 8);
 
     if (arm9) {
         // Send interrupts to the ARM11 if requested and enabled
-        if ((value & mask & BIT(29)) && (pxiSync[0] & BIT(31)))
-            core.interrupts.sendInterrupt(ARM11, 0x50);
-        if ((value & mask & BIT(30)) && (pxiSync[0] & BIT(31)))
-            core.interrupts.sendInterrupt(ARM11, 0x51);
+        if ((value & mask & BIT(29)) && syncIrq[0].load())
+            sendInterrupt(false, 0x50);
+        if ((value & mask & BIT(30)) && syncIrq[0].load())
+            sendInterrupt(false, 0x51);
     }
     else {
         // Send an interrupt to the ARM9 if requested and enabled
-        if ((value & mask & BIT(30)) && (pxiSync[1] & BIT(31)))
-            core.interrupts.sendInterrupt(ARM9, 12);
+        if ((value & mask & BIT(30)) && syncIrq[1].load())
+            sendInterrupt(true, 12);
     }
 
     // Write to this CPU's PXI_SYNC interrupt enable bit
-    mask &= 0x80000000;
-    pxiSync[arm9] = (pxiSync[arm9] & ~mask) | (value & mask);
+    if (mask & BIT(31))
+        syncIrq[arm9].store(value & BIT(31));
 }
 
 void Pxi::writeCnt(bool arm9, uint16_t mask, uint16_t value) {
     // Check the interrupt conditions before writing to the register
-    bool sendCond = (pxiCnt[arm9] & BIT(0)) && (pxiCnt[arm9] & BIT(2));
-    bool recvCond = (~pxiCnt[arm9] & BIT(8)) && (pxiCnt[arm9] & BIT(10));
-
-    // Clear this CPU's send FIFO if the clear bit is set
-    if ((value & mask & BIT(3)) && !fifos[arm9].empty()) {
-        // Empty the FIFO
-        fifos[arm9] = {};
-        pxiRecv[!arm9] = 0;
-
-        // Set the FIFO empty bits and clear the FIFO full bits
-        pxiCnt[arm9] = (pxiCnt[arm9] | BIT(0)) & ~BIT(1);
-        pxiCnt[!arm9] = (pxiCnt[!arm9] | BIT(8)) & ~BIT(9);
-    }
+    std::unique_lock<std::mutex> lock = lockSide(arm9);
+    uint16_t cnt = readCnt(arm9);
+    bool sendCond = (cnt & BIT(0)) && (cnt & BIT(2));
+    bool recvCond = (~cnt & BIT(8)) && (cnt & BIT(10));
 
-    // Write to this CPU's PXI_CNT enable bits
-    mask &= 0x8404;
-    pxiCnt[arm9] = (pxiCnt[arm9] & ~mask) | (value & mask);
+    // Clear this CPU's send FIFO if the clear bit is set, which the other CPU applies when it next receives
+    if ((value & mask & BIT(3)) && !fifos[arm9].empty())
+        fifos[arm9].clear();
 
-    // Acknowledge the error bit if it's set
+    // Write to this CPU's PXI_CNT enable bits, and acknowledge the error bit if it's set
+    mask &= 0x8404;
+    cnt = (pxiCnt[arm9].load() & ~mask) | (value & mask);
     if (value & BIT(14))
-        pxiCnt[arm9] &= ~BIT(14);
+        cnt &= ~BIT(14);
+    pxiCnt[arm9].store(cnt);
 
     // Trigger a send FIFO empty interrupt if the condition changed to true
-    if (!sendCond && (pxiCnt[arm9] & BIT(0)) && (pxiCnt[arm9] & BIT(2)))
-        core.interrupts.sendInterrupt(arm9 ? ARM9 : ARM11, arm9 ? 13 : 0x52);
+    cnt = readCnt(arm9);
+    if (lock) lock.unlock();
+    if (!sendCond && (cnt & BIT(0)) && (cnt & BIT(2)))
+        sendInterrupt(arm9, arm9 ? 13 : 0x52);
 
     // Trigger a receive FIFO not empty interrupt if the condition changed to true
-    if (!recvCond && (~pxiCnt[arm9] & BIT(8)) && (pxiCnt[arm9] & BIT(10)))
-        core.interrupts.sendInterrupt(arm9 ? ARM9 : ARM11, arm9 ? 14 : 0x53);
+    if (!recvCond && (~cnt & BIT(8)) && (cnt & BIT(10)))
+        sendInterrupt(arm9, arm9 ? 14 : 0x53);
 }
 
 void Pxi::writeSend(bool arm9, uint32_t mask, uint32_t value) {
     // Ensure the FIFO is enabled
-    if (~pxiCnt[arm9] & BIT(15))
+    std::unique_lock<std::mutex> lock = lockSide(arm9);
+    if (~pxiCnt[arm9].load() & BIT(15))
         return;
 
     // Report an error if the FIFO is full
-    if (pxiCnt[arm9] & BIT(1)) {
-        pxiCnt[arm9] |= BIT(14);
+    uint32_t size = fifos[arm9].size();
+    if (size >= 16) {
+        pxiCnt[arm9].fetch_or(BIT(14));
         return;
     }
 
@@ -123,18 +156,21 @@ void Pxi::writeSend(bool arm9, uint32_t mask, uint32_t value) {
     fifos[arm9].push(value & mask);
     LOG_INFO("ARM%d sending value through PXI FIFO: 0x%X\n", arm9 ? 9 : 11, value & mask);
 
-    if (fifos[arm9].size() == 1) {
-        // Clear the empty bits if the FIFO is no longer empty
-        pxiCnt[arm9] &= ~BIT(0);
-        pxiCnt[!arm9] &= ~BIT(8);
+    // Send a receive FIFO not empty interrupt to the other CPU if no longer empty and enabled
+    if (lock) lock.unlock();
+    if (size == 0 && (pxiCnt[!arm9].load() & BIT(10)))
+        sendInterrupt(!arm9, arm9 ? 0x53 : 14);
+}
 
-        // Send a receive FIFO not empty interrupt to the other CPU if enabled
-        if (pxiCnt[!arm9] & BIT(10))
-            core.interrupts.sendInterrupt(arm9 ? ARM11 : ARM9, arm9 ? 0x53 : 14);
-    }
-    else if (fifos[arm9].size() == 16) {
-        // Set the full bits if the FIFO is now full
-        pxiCnt[arm9] |= BIT(1);
-        pxiCnt[!arm9] |= BIT(9);
-    }
+std::unique_lock<std::mutex> Pxi::lockSide(bool arm9) {
+    // Keep ARM11 cores on separate threads from using their side at once, since each side of a FIFO has one owner
+    std::unique_lock<std::mutex> lock(arm11Mutex, std::defer_lock);
+    if (!arm9 && core.threadedArm11) lock.lock();
+    return lock;
+}
+
+void Pxi::sendInterrupt(bool arm9, int type) {
+    // Take the core lock only to raise an interrupt, since it goes through the scheduler
+    CoreLock lock(core);
+    core.interrupts.sendInterrupt(arm9 ? ARM9 : ARM11, type);
 }
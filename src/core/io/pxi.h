@@ -19,17 +19,69 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <queue>
+#include <mutex>
 
 class Core;
+class SaveState;
+
+class PxiFifo {
+public:
+    // Track the FIFO with free-running indices so the sending and receiving sides each write only their own
+    bool empty() const { return !size(); }
+    bool full() const { return size() >= 16; }
+    uint32_t size() const { return tail.load(std::memory_order_acquire) - start(); }
+    void serialize(SaveState &s);
+
+    // Store a value before publishing it to the receiving side
+    void push(uint32_t value) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        data[t & 0xF].store(value, std::memory_order_relaxed);
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    // Request a clear from the sending side, which the receiving side applies by skipping to the mark
+    void clear() { discard.store(tail.load(std::memory_order_relaxed), std::memory_order_release); }
+
+    // Take a value on the receiving side and release its slot back to the sending side
+    uint32_t pop() {
+        uint32_t h = start();
+        uint32_t value = data[h & 0xF].load(std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Check on the receiving side if the sending side has cleared the FIFO since the last check
+    bool cleared() {
+        uint32_t d = discard.load(std::memory_order_acquire);
+        if (d == seen) return false;
+        seen = d;
+        return true;
+    }
+
+private:
+    std::atomic<uint32_t> data[16] = {};
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    std::atomic<uint32_t> discard{0};
+    uint32_t seen = 0;
+
+    uint32_t start() const {
+        // Get the first live index, skipping anything before a clear mark
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t d = discard.load(std::memory_order_acquire);
+        return (int32_t(d - h) > 0) ? d : h;
+    }
+};
 
 class Pxi {
 public:
     Pxi(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
-    uint32_t readSync(bool arm9) { return pxiSync[arm9]; }
-    uint16_t readCnt(bool arm9) { return pxiCnt[arm9]; }
+    uint32_t readSync(bool arm9) { return syncData[arm9].load() | (uint32_t(syncIrq[arm9].load()) << 31); }
+    uint16_t readCnt(bool arm9);
     uint32_t readRecv(bool arm9);
 
     void writeSync(bool arm9, uint32_t mask, uint32_t value);
@@ -38,9 +90,14 @@ public:
 
 private:
     Core &core;
-    std::queue<uint32_t> fifos[2];
+    PxiFifo fifos[2];
+    std::mutex arm11Mutex;
 
-    uint32_t pxiSync[2] = {};
-    uint16_t pxiCnt[2] = { 0x101, 0x101 };
+    std::atomic<uint8_t> syncData[2] = {};
+    std::atomic<bool> syncIrq[2] = {};
+    std::atomic<uint16_t> pxiCnt[2] = {};
     uint32_t pxiRecv[2] = {};
+
+    std::unique_lock<std::mutex> lockSide(bool arm9);
+    void sendInterrupt(bool arm9, int type);
 };
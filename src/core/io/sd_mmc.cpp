@@ -27,6 +27,37 @@ SdMmc::~SdMmc() {
     if (sd) fclose(sd);
 }
 
+void SdMmc::flush() {
+    // Write out buffered changes to the NAND and SD files
+    if (nand) fflush(nand);
+    if (sd) fflush(sd);
+}
+
+void SdMmc::serialize(SaveState &s) {
+    // Transfer the controller state, leaving the image files as they are
+    s.io(cardStatus);
+    s.io(opCond);
+    s.io(blockLen);
+    s.io(curAddress);
+    s.io(curBlock);
+    s.io(dataFifo16);
+    s.io(dataFifo32);
+    s.io(sdCmd);
+    s.io(sdPortSelect);
+    s.io(sdCmdParam);
+    s.io(sdData16Blkcnt);
+    s.io(sdResponse);
+    s.io(sdIrqStatus);
+    s.io(sdIrqMask);
+    s.io(sdData16Blklen);
+    s.io(sdErrDetail);
+    s.io(sdData16Fifo);
+    s.io(sdDataCtl);
+    s.io(sdData32Irq);
+    s.io(sdData32Blklen);
+    s.io(sdData32Fifo);
+}
+
 bool SdMmc::init(SdMmc &other) {
     // Try to open an SD image to share between ports
     other.sd = sd = fopen(Settings::sdPath.c_str(), "rb+");
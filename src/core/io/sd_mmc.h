@@ -23,13 +23,16 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 class SdMmc {
 public:
     SdMmc(Core &core): core(core) {}
+    void serialize(SaveState &s);
     ~SdMmc();
 
     bool init(SdMmc &other);
+    void flush();
     void readBlock();
     void writeBlock();
 
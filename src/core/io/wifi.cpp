@@ -56,6 +56,44 @@ const uint8_t Wifi::func0Cis1[] = {
     0x01, 0x00 // 0x40-0x41
 };
 
+void Wifi::serialize(SaveState &s) {
+    // Transfer the SDIO state and Xtensa RAM
+    s.io(cardStatus);
+    s.io(blockLen);
+    s.io(curAddress);
+    s.io(curBlock);
+    s.io(curFunc);
+    s.io(curInc);
+    s.ram((uint8_t*)xtensaRam, sizeof(xtensaRam));
+    s.io(bootStage);
+    s.io(dataFifo16);
+    s.io(dataFifo32);
+    for (int i = 0; i < 8; i++)
+        s.io(mboxes[i]);
+    s.io(f0IntStat);
+    s.io(f0IntMask);
+    s.io(rxLookValid);
+    s.io(f1IntStat);
+    s.io(f1IntMask);
+    s.io(winData);
+    s.io(winWriteAddr);
+    s.io(winReadAddr);
+    s.io(wifiCmd);
+    s.io(wifiCmdParam);
+    s.io(wifiResponse);
+    s.io(wifiIrqStatus);
+    s.io(wifiIrqMask);
+    s.io(wifiData16Blklen);
+    s.io(wifiErrDetail);
+    s.io(wifiData16Fifo);
+    s.io(wifiCardIrqStat);
+    s.io(wifiCardIrqMask);
+    s.io(wifiDataCtl);
+    s.io(wifiData32Irq);
+    s.io(wifiData32Blklen);
+    s.io(wifiData32Fifo);
+}
+
 void Wifi::extInterrupt(int bit) {
     // Set an external interrupt request bit
     wifiIrqStatus |= BIT(bit);
@@ -24,10 +24,12 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 class Wifi {
 public:
     Wifi(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     void readBlock();
     void writeBlock();
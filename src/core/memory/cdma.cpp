@@ -24,6 +24,30 @@ Cdma::Cdma(Core &core, CdmaId id): core(core), id(id) {
     cpu = (id == XDMA) ? ARM9 : ARM11;
 }
 
+void Cdma::serialize(SaveState &s) {
+    // Transfer the CDMA FIFOs and registers
+    for (int i = 0; i < 8; i++)
+        s.io(fifos[i]);
+    s.io(drqMask);
+    s.io(dbgId);
+    s.io(burstReq);
+    s.io(inten);
+    s.io(intEventRis);
+    s.io(intmis);
+    s.io(fsrc);
+    s.io(ftrs);
+    s.io(csrs);
+    s.io(cpcs);
+    s.io(sars);
+    s.io(dars);
+    s.io(ccrs);
+    s.io(lc0s);
+    s.io(lc1s);
+    s.io(dbgstatus);
+    s.io(dbginst0);
+    s.io(dbginst1);
+}
+
 void Cdma::setDrq(uint8_t type) {
     // Set a DRQ type's active bit
     drqMask |= BIT(type);
@@ -41,9 +65,7 @@ void Cdma::clearDrq(uint8_t type) {
 
 void Cdma::triggerUpdate() {
     // Schedule a CDMA update if one hasn't been already
-    if (scheduled) return;
-    core.schedule(Task(CDMA0_UPDATE + id), 1);
-    scheduled = true;
+    core.scheduleOnce(Task(CDMA0_UPDATE + id), 1);
 }
 
 void Cdma::update() {
@@ -53,9 +75,13 @@ void Cdma::update() {
             csrs[i] = (csrs[i] & ~0xC1FF) | 0x1; // Executing
 
     // Run any channels that are now executing
-    scheduled = false;
     for (int i = 0; i < 9; i++)
         if ((csrs[i] & 0xF) == 0x1) runOpcodes(i);
+
+    // Update again if a DRQ was raised while running, since triggers from inside an update are merged into it
+    for (int i = 0; i < 8; i++)
+        if ((csrs[i] & 0xF) == 0x7 && (drqMask & BIT((csrs[i] >> 4) & 0x1F)))
+            return core.schedule(Task(CDMA0_UPDATE + id), 1);
 }
 
 void Cdma::runOpcodes(int i) {
@@ -23,6 +23,7 @@
 #include <queue>
 
 class Core;
+class SaveState;
 
 enum CdmaId {
     CDMA0,
@@ -33,6 +34,7 @@ enum CdmaId {
 class Cdma {
 public:
     Cdma(Core &core, CdmaId id);
+    void serialize(SaveState &s);
 
     void setDrq(uint8_t type);
     void clearDrq(uint8_t type);
@@ -70,7 +72,6 @@ private:
     uint32_t drqMask = 0;
     uint8_t dbgId = 0;
     bool burstReq = false;
-    bool scheduled = false;
 
     uint32_t inten = 0;
     uint32_t intEventRis = 0;
@@ -20,6 +20,15 @@
 #include <cstring>
 #include "../core.h"
 
+#ifdef FAST_MEM
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Track the instance whose host views are write-protected, since signal handlers are process-wide
+static Memory *trapMemory = nullptr;
+static struct sigaction oldFault;
+#endif
+
 template uint8_t Memory::readFallback(CpuId, uint32_t);
 template uint16_t Memory::readFallback(CpuId, uint32_t);
 template uint32_t Memory::readFallback(CpuId, uint32_t);
@@ -28,18 +37,49 @@ template void Memory::writeFallback(CpuId, uint32_t, uint16_t);
 template void Memory::writeFallback(CpuId, uint32_t, uint32_t);
 
 Memory::~Memory() {
-    // Free extended FCRAM and VRAM
-    delete[] fcramExt;
-    delete[] vramExt;
+#ifdef FAST_MEM
+    // Restore the previous fault handler if this instance installed its own
+    if (trapMemory == this) {
+        sigaction(SIGSEGV, &oldFault, nullptr);
+        trapMemory = nullptr;
+    }
+
+    // Unmap the host memory views and the RAM block if it came from a memory file
+    if (fastMem11) munmap(fastMem11, 0x100000000);
+    if (fastMem9) munmap(fastMem9, 0x100000000);
+    if (memFd >= 0) {
+        if (backing) munmap(backing, backingSize);
+        close(memFd);
+        return;
+    }
+#endif
+
+    // Free the RAM block
+    delete[] backing;
 }
 
 bool Memory::init() {
-    // Allocate extended FCRAM and VRAM if running in new 3DS mode
+    // Size one block to hold all RAM regions, including extended FCRAM and VRAM if running in new 3DS mode
+    backingSize = 0x180000 + 0x600000 + 0x80000 + 0x80000 + 0x8000000 + 0x10000 + 0x10000;
+    if (core.n3dsMode) backingSize += 0x8000000 + 0x400000;
+
+    // Allocate the block from a memory file if fast memory is enabled, or from the heap otherwise
+    if (!Settings::fastMem || !initFastMem(backingSize)) {
+        backing = new uint8_t[backingSize];
+        memset(backing, 0, backingSize);
+    }
+
+    // Split the block into RAM regions
+    arm9Ram = backing;
+    vram = arm9Ram + 0x180000;
+    dspWram = vram + 0x600000;
+    axiWram = dspWram + 0x80000;
+    fcram = axiWram + 0x80000;
+    boot11 = fcram + 0x8000000;
+    boot9 = boot11 + 0x10000;
     if (core.n3dsMode) {
-        fcramExt = new uint8_t[0x8000000];
-        memset(fcramExt, 0, 0x8000000);
-        vramExt = new uint8_t[0x400000];
-        memset(vramExt, 0, 0x400000);
+        fcramExt = boot9 + 0x10000;
+        vramExt = fcramExt + 0x8000000;
     }
 
     // Initialize the memory maps
@@ -60,6 +100,85 @@ bool Memory::init() {
     return true;
 }
 
+bool Memory::initFastMem(size_t size) {
+#ifdef FAST_MEM
+    // Require 4KB host pages, since guest pages are mapped into the views individually
+    if (sysconf(_SC_PAGESIZE) != 0x1000) {
+        LOG_WARN("Fast memory needs 4KB host pages; falling back to regular memory\n");
+        return false;
+    }
+
+    // Back RAM with a memory file and map all of it once for regular access
+    if ((memFd = memfd_create("3beans-ram", 0)) >= 0 && !ftruncate(memFd, size)) {
+        void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memFd, 0);
+        backing = (mem == MAP_FAILED) ? nullptr : (uint8_t*)mem;
+    }
+
+    // Reserve 4GB views of the ARM11 and ARM9 physical address spaces, left inaccessible until mapped
+    for (int i = 0; i < 2 && backing; i++) {
+        void *mem = mmap(nullptr, 0x100000000, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        (i ? fastMem9 : fastMem11) = (mem == MAP_FAILED) ? nullptr : (uint8_t*)mem;
+    }
+    if (fastMem11 && fastMem9) {
+        // Catch writes to watched pages with a fault handler, unless another instance already owns it
+        if (!trapMemory) {
+            struct sigaction action = {};
+            action.sa_sigaction = writeFault;
+            action.sa_flags = SA_SIGINFO;
+            sigemptyset(&action.sa_mask);
+            if (!sigaction(SIGSEGV, &action, &oldFault)) {
+                trapMemory = this;
+                trapWrites = true;
+                write8 = &Memory::writeMap<uint8_t, false>;
+                write16 = &Memory::writeMap<uint16_t, false>;
+                write32 = &Memory::writeMap<uint32_t, false>;
+            }
+        }
+        return true;
+    }
+
+    // Clean up and fall back to regular memory if anything failed
+    LOG_WARN("Failed to set up fast memory; falling back to regular memory\n");
+    if (fastMem11) munmap(fastMem11, 0x100000000);
+    if (backing) munmap(backing, size);
+    if (memFd >= 0) close(memFd);
+    fastMem11 = fastMem9 = backing = nullptr;
+    memFd = -1;
+#endif
+    return false;
+}
+
+void Memory::serialize(SaveState &s) {
+    // Transfer all RAM regions, skipping pages that are still zeroed
+    s.ram(arm9Ram, 0x180000);
+    s.ram(vram, 0x600000);
+    s.ram(dspWram, 0x80000);
+    s.ram(axiWram, 0x80000);
+    s.ram(fcram, 0x8000000);
+    s.ram(boot11, 0x10000);
+    s.ram(boot9, 0x10000);
+    if (fcramExt) s.ram(fcramExt, 0x8000000);
+    if (vramExt) s.ram(vramExt, 0x400000);
+
+    // Transfer the config registers
+    s.io(cfg11Wram32kCode);
+    s.io(cfg11Wram32kData);
+    s.io(cfg11BrOverlayCnt);
+    s.io(cfg11BrOverlayVal);
+    s.io(cfg11MpCnt);
+    s.io(cfg9Sysprot9);
+    s.io(cfg9Sysprot11);
+    s.io(cfg9Extmemcnt9);
+    s.io(cfg9Bootenv);
+    s.io(prngSource);
+    s.io(otpEncrypted);
+
+    // Rebuild the memory maps from the loaded registers
+    if (!s.loading) return;
+    updateMap(false, 0x0, 0xFFFFFFFF);
+    updateMap(true, 0x0, 0xFFFFFFFF);
+}
+
 void Memory::loadOtp(FILE *file) {
     // Load encrypted OTP data from a file
     fread(otpEncrypted, sizeof(uint32_t), 0x40, file);
@@ -138,20 +257,133 @@ void Memory::updateMap(bool arm9, uint32_t start, uint32_t end) {
             map.write = &boot11[address & 0xFFFF];
     }
 
+    // Point the map into the host view if fast memory is enabled
+    if (fastMem11) updateFastMem(arm9, start, end);
+
     // Update the virtual memory maps as well
     if (arm9) return core.cp15.updateMap9(start, end);
     for (int i = 0; i < MAX_CPUS - 1; i++)
         core.cp15.mmuInvalidate(CpuId(i));
 }
 
+void Memory::updateFastMem(bool arm9, uint32_t start, uint32_t end) {
+#ifdef FAST_MEM
+    // Mirror part of a physical memory map into its host view, so RAM pages alias the memory file at their guest address
+    uint8_t *view = (arm9 ? fastMem9 : fastMem11);
+    uint64_t runStart = start;
+    size_t runOffset = 0;
+    int runProt = PROT_NONE;
+    for (uint64_t address = start; address <= uint64_t(end) + 1; address += 0x1000) {
+        size_t offset = 0;
+        int prot = PROT_NONE;
+        if (address <= end) {
+            // Drop any watch on a page and signal change, since remapping resets protection and may change contents
+            __atomic_fetch_and(&watchBits[address >> 17], ~BIT((address >> 12) & 0x1F), __ATOMIC_ACQ_REL);
+            __atomic_fetch_add(&memMap11[address >> 12].tag, 1, __ATOMIC_RELAXED);
+
+            // Find which part of the RAM block backs the page and how it can be accessed
+            // Pages that read and write different memory can't be represented, so they keep their direct pointers
+            MemMap &map = (arm9 ? memMap9 : memMap11)[address >> 12];
+            uint8_t *data = map.read ? map.read : map.write;
+            if (data && (!map.read || !map.write || map.read == map.write)) {
+                offset = data - backing;
+                prot = (map.read ? PROT_READ : 0) | (map.write ? PROT_WRITE : 0);
+                if (map.read) map.read = &view[address];
+                if (map.write) map.write = &view[address];
+            }
+        }
+
+        // Extend the current run of pages if this one continues it
+        if (address != runStart && address <= end && prot == runProt &&
+            (prot == PROT_NONE || offset == runOffset + (address - runStart)))
+            continue;
+
+        // Map the finished run, either to the memory file or back to inaccessible space
+        if (address != runStart) {
+            void *mem;
+            if (runProt != PROT_NONE)
+                mem = mmap(&view[runStart], address - runStart, runProt, MAP_SHARED | MAP_FIXED, memFd, runOffset);
+            else
+                mem = mmap(&view[runStart], address - runStart, PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+            if (mem == MAP_FAILED)
+                LOG_CRIT("Failed to map fast memory at 0x%X\n", uint32_t(runStart));
+        }
+
+        // Start a new run with this page
+        runStart = address;
+        runOffset = offset;
+        runProt = prot;
+    }
+#endif
+}
+
+void Memory::watchPage(uint32_t address) {
+    // Mark a page as watched so its next write updates the tag, unless it already is
+    uint32_t &bits = watchBits[address >> 17];
+    uint32_t bit = BIT((address >> 12) & 0x1F);
+    if ((__atomic_load_n(&bits, __ATOMIC_ACQUIRE) & bit) || (__atomic_fetch_or(&bits, bit, __ATOMIC_SEQ_CST) & bit))
+        return;
+
+    // Write-protect the page in the host views, or drop CPU fast mappings that would write it without the tag
+#ifdef FAST_MEM
+    if (trapWrites) return protectPage(address, PROT_READ);
+#endif
+    core.cp15.dropFastWrites(address);
+}
+
+void Memory::protectPage(uint32_t address, int prot) {
+#ifdef FAST_MEM
+    // Change access to a page in whichever host views map it as writable memory
+    address &= ~0xFFF;
+    if (memMap11[address >> 12].write == &fastMem11[address])
+        mprotect(&fastMem11[address], 0x1000, prot);
+    if (memMap9[address >> 12].write == &fastMem9[address])
+        mprotect(&fastMem9[address], 0x1000, prot);
+#endif
+}
+
+#ifdef FAST_MEM
+void Memory::writeFault(int sig, siginfo_t *info, void *context) {
+    // Check if a fault hit a writable page in one of the host views
+    if (Memory *mem = trapMemory) {
+        uint8_t *addr = (uint8_t*)info->si_addr;
+        for (int i = 0; i < 2; i++) {
+            uint8_t *view = (i ? mem->fastMem9 : mem->fastMem11);
+            if (addr < view || addr >= view + 0x100000000) continue;
+            uint32_t address = (addr - view) & ~0xFFF;
+            if ((i ? mem->memMap9 : mem->memMap11)[address >> 12].write != &view[address]) break;
+
+            // Record the write by clearing the watch and updating the tag, then lift protection so it can retry
+            __atomic_fetch_and(&mem->watchBits[address >> 17], ~BIT((address >> 12) & 0x1F), __ATOMIC_ACQ_REL);
+            __atomic_fetch_add(&mem->memMap11[address >> 12].tag, 1, __ATOMIC_RELAXED);
+            mem->protectPage(address, PROT_READ | PROT_WRITE);
+            return;
+        }
+    }
+
+    // Pass other faults on to the previous handler, or let them happen again without one
+    if (oldFault.sa_flags & SA_SIGINFO)
+        oldFault.sa_sigaction(sig, info, context);
+    else if (oldFault.sa_handler != SIG_DFL && oldFault.sa_handler != SIG_IGN)
+        oldFault.sa_handler(sig);
+    else
+        signal(sig, SIG_DFL);
+}
+#endif
+
 template <typename T> T Memory::readFallback(CpuId id, uint32_t address) {
-    // Forward a read to I/O registers if within range
-    if (address >= 0x10000000 && address < 0x18000000)
+    // Forward a read to I/O registers if within range, leaving PXI to sync between the CPUs itself
+    if (address >= 0x10000000 && address < 0x18000000) {
+        if ((address & ~0xF) == ((id == ARM9) ? 0x10008000 : 0x10163000))
+            return ioRead<T>(id, address);
+        CoreLock lock(core);
         return ioRead<T>(id, address);
+    }
 
     // Handle the ARM11 bootrom overlay if reads to it have fallen through
     if (id != ARM9 && (address < 0x20000 || address >= 0xFFFF0000))
-        return (address == *core.arms[id].registers[15]) ? 0xE59FF018 : cfg11BrOverlayVal;
+        return (address == core.arms[id].registers[15]) ? 0xE59FF018 : cfg11BrOverlayVal;
 
     // Catch reads from unmapped memory
     if (id == ARM9)
@@ -162,9 +394,13 @@ template <typename T> T Memory::readFallback(CpuId id, uint32_t address) {
 }
 
 template <typename T> void Memory::writeFallback(CpuId id, uint32_t address, T value) {
-    // Forward a write to I/O registers if within range
-    if (address >= 0x10000000 && address < 0x18000000)
+    // Forward a write to I/O registers if within range, leaving PXI to sync between the CPUs itself
+    if (address >= 0x10000000 && address < 0x18000000) {
+        if ((address & ~0xF) == ((id == ARM9) ? 0x10008000 : 0x10163000))
+            return ioWrite<T>(id, address, value);
+        CoreLock lock(core);
         return ioWrite<T>(id, address, value);
+    }
 
     // Catch writes to unmapped memory
     if (id == ARM9)
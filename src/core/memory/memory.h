@@ -19,8 +19,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
+// Host views of guest memory rely on memory files, which are only used on Linux
+#ifdef __linux__
+#define FAST_MEM
+#include <csignal>
+#endif
+
 #define DEF_IO08(addr, func) \
     case addr + 0: \
         base &= 0x0; \
@@ -47,6 +54,7 @@
 #define IO_PARAMS8 data << (base << 3)
 
 class Core;
+class SaveState;
 
 struct MemMap {
     uint8_t *read, *write;
@@ -57,11 +65,14 @@ class Memory {
 public:
     MemMap memMap11[0x100000] = {};
     MemMap memMap9[0x100000] = {};
+    bool atomicTags = false;
+    bool trapWrites = false;
 
     Memory(Core &core): core(core) {}
     ~Memory();
 
     bool init();
+    void serialize(SaveState &s);
     void loadOtp(FILE *file);
     void updateMap(bool arm9, uint32_t start, uint32_t end);
 
@@ -70,17 +81,32 @@ public:
 
     template <typename T> T readFallback(CpuId id, uint32_t address);
     template <typename T> void writeFallback(CpuId id, uint32_t address, T value);
+    void updateTag(uint32_t &tag);
+    void watchPage(uint32_t address);
+    bool unwatchPage(uint32_t address);
+    bool isWatched(uint32_t address);
 
 private:
     Core &core;
 
-    uint8_t arm9Ram[0x180000] = {}; // 1.5MB ARM9 internal RAM
-    uint8_t vram[0x600000] = {}; // 6MB VRAM
-    uint8_t dspWram[0x80000] = {}; // 512KB DSP code/data RAM
-    uint8_t axiWram[0x80000] = {}; // 512KB AXI WRAM
-    uint8_t fcram[0x8000000] = {}; // 128MB FCRAM
-    uint8_t boot11[0x10000] = {}; // 64KB ARM11 boot ROM
-    uint8_t boot9[0x10000] = {}; // 64KB ARM9 boot ROM
+    uint8_t *backing = nullptr;
+    size_t backingSize = 0;
+    int memFd = -1;
+    uint8_t *fastMem11 = nullptr;
+    uint8_t *fastMem9 = nullptr;
+    uint32_t watchBits[0x100000 >> 5] = {};
+
+    void (Memory::*write8)(CpuId, uint32_t, uint8_t) = &Memory::writeMap<uint8_t, true>;
+    void (Memory::*write16)(CpuId, uint32_t, uint16_t) = &Memory::writeMap<uint16_t, true>;
+    void (Memory::*write32)(CpuId, uint32_t, uint32_t) = &Memory::writeMap<uint32_t, true>;
+
+    uint8_t *arm9Ram = nullptr; // 1.5MB ARM9 internal RAM
+    uint8_t *vram = nullptr; // 6MB VRAM
+    uint8_t *dspWram = nullptr; // 512KB DSP code/data RAM
+    uint8_t *axiWram = nullptr; // 512KB AXI WRAM
+    uint8_t *fcram = nullptr; // 128MB FCRAM
+    uint8_t *boot11 = nullptr; // 64KB ARM11 boot ROM
+    uint8_t *boot9 = nullptr; // 64KB ARM9 boot ROM
     uint8_t *fcramExt = nullptr; // 128MB extended FCRAM
     uint8_t *vramExt = nullptr; // 4MB extended VRAM
 
@@ -96,6 +122,14 @@ private:
     uint32_t prngSource[3] = {};
     uint32_t otpEncrypted[0x40] = {};
 
+    bool initFastMem(size_t size);
+    void updateFastMem(bool arm9, uint32_t start, uint32_t end);
+    void protectPage(uint32_t address, int prot);
+#ifdef FAST_MEM
+    static void writeFault(int sig, siginfo_t *info, void *context);
+#endif
+
+    template <typename T, bool tags> void writeMap(CpuId id, uint32_t address, T value);
     template <typename T> T ioRead(CpuId id, uint32_t address);
     template <typename T> void ioWrite(CpuId id, uint32_t address, T value);
 
@@ -123,6 +157,32 @@ private:
     void writeCfg9Bootenv(uint32_t mask, uint32_t value);
 };
 
+FORCE_INLINE void Memory::updateTag(uint32_t &tag) {
+    // Increment a memory tag, atomically if ARM11 cores are writing from separate threads
+    // Tags are left alone when writes to watched pages are caught through host page protection instead
+    if (trapWrites)
+        return;
+    else if (atomicTags)
+        __atomic_fetch_add(&tag, 1, __ATOMIC_RELAXED);
+    else
+        tag++;
+}
+
+FORCE_INLINE bool Memory::unwatchPage(uint32_t address) {
+    // Clear a page's watch ahead of a write that updates its tag, unless writes are caught through page protection
+    uint32_t &bits = watchBits[address >> 17];
+    uint32_t bit = BIT((address >> 12) & 0x1F);
+    if (trapWrites || !(__atomic_load_n(&bits, __ATOMIC_ACQUIRE) & bit)) return false;
+    return __atomic_fetch_and(&bits, ~bit, __ATOMIC_ACQ_REL) & bit;
+}
+
+FORCE_INLINE bool Memory::isWatched(uint32_t address) {
+    // Check if a page is watched, ordered after any fast mapping just cached for it so a racing watch can't miss it
+    if (trapWrites) return false;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return __atomic_load_n(&watchBits[address >> 17], __ATOMIC_ACQUIRE) & BIT((address >> 12) & 0x1F);
+}
+
 template <typename T> FORCE_INLINE T Memory::read(CpuId id, uint32_t address) {
     // Look up a readable memory pointer and load an LSB-first value if it exists
     if (uint8_t *data = (id == ARM9 ? memMap9 : memMap11)[address >> 12].read) {
@@ -135,10 +195,16 @@ template <typename T> FORCE_INLINE T Memory::read(CpuId id, uint32_t address) {
     return readFallback<T>(id, address);
 }
 
-template <typename T> FORCE_INLINE void Memory::write(CpuId id, uint32_t address, T value) {
-    // Look up a writable memory pointer and adjust its tag to signal change
+template <typename T, bool tags> FORCE_INLINE void Memory::writeMap(CpuId id, uint32_t address, T value) {
+    // Look up a writable memory pointer and adjust its tag to signal change, unless writes are trapped instead
+    // Tags are kept in the ARM11 map for both CPUs, since they share the same physical addresses
     MemMap &map = (id == ARM9 ? memMap9 : memMap11)[address >> 12];
-    map.tag++;
+    if (tags) {
+        if (atomicTags)
+            __atomic_fetch_add(&memMap11[address >> 12].tag, 1, __ATOMIC_RELAXED);
+        else
+            memMap11[address >> 12].tag++;
+    }
 
     // Store an LSB-first value if the pointer exists, or fall back
     if (uint8_t *data = map.write) {
@@ -149,3 +215,16 @@ template <typename T> FORCE_INLINE void Memory::write(CpuId id, uint32_t address
     }
     return writeFallback<T>(id, address, value);
 }
+
+// Send writes through the store path chosen when memory was set up
+template <> FORCE_INLINE void Memory::write(CpuId id, uint32_t address, uint8_t value) {
+    (this->*write8)(id, address, value);
+}
+
+template <> FORCE_INLINE void Memory::write(CpuId id, uint32_t address, uint16_t value) {
+    (this->*write16)(id, address, value);
+}
+
+template <> FORCE_INLINE void Memory::write(CpuId id, uint32_t address, uint32_t value) {
+    (this->*write32)(id, address, value);
+}
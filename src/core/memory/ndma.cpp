@@ -19,6 +19,20 @@
 
 #include "../core.h"
 
+void Ndma::serialize(SaveState &s) {
+    // Transfer the NDMA channel registers
+    s.io(srcAddrs);
+    s.io(dstAddrs);
+    s.io(drqMask);
+    s.io(runMask);
+    s.io(ndmaSad);
+    s.io(ndmaDad);
+    s.io(ndmaTcnt);
+    s.io(ndmaWcnt);
+    s.io(ndmaFdata);
+    s.io(ndmaCnt);
+}
+
 bool Ndma::shouldTransfer(int i, uint8_t type) {
     // Check if a channel is enabled and using the triggered DRQ type
     if (~ndmaCnt[i] & BIT(31)) return false;
@@ -22,10 +22,12 @@
 #include <cstdint>
 
 class Core;
+class SaveState;
 
 class Ndma {
 public:
     Ndma(Core &core): core(core) {}
+    void serialize(SaveState &s);
 
     void setDrq(uint8_t type);
     void clearDrq(uint8_t type);
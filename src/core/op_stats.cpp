@@ -0,0 +1,43 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include "op_stats.h"
+
+void writeOps(FILE *file, const char *name, std::vector<OpGroup> &groups) {
+    // Sort handlers by the cycles they took, and total everything up
+    std::sort(groups.begin(), groups.end(),
+        [](const OpGroup &a, const OpGroup &b) { return a.stat.cycles > b.stat.cycles; });
+    uint64_t count = 0, cycles = 0;
+    for (size_t i = 0; i < groups.size(); i++) {
+        count += groups[i].stat.count;
+        cycles += groups[i].stat.cycles;
+    }
+
+    // Write a report section with a line for each handler
+    fprintf(file, "%s: %llu handler calls, %llu cycles\n", name, (unsigned long long)count, (unsigned long long)cycles);
+    fprintf(file, "%14s %7s %14s  %s\n", "cycles", "share", "count", "handler (example opcode)");
+    for (size_t i = 0; i < groups.size(); i++) {
+        OpStat &stat = groups[i].stat;
+        fprintf(file, "%14llu %6.2f%% %14llu  %s[0x%X] (0x%X)\n", (unsigned long long)stat.cycles,
+            cycles ? stat.cycles * 100.0 / cycles : 0.0, (unsigned long long)stat.count,
+            groups[i].table, groups[i].index, stat.opcode);
+    }
+    fprintf(file, "\n");
+}
@@ -0,0 +1,69 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "defines.h"
+
+// Wrap a handler call to count it when built with OP_STATS, or pass its cycles through otherwise
+#if OP_STATS
+#define COUNT_OP(stat, opcode, cycles) countOp(stat, opcode, cycles)
+#else
+#define COUNT_OP(stat, opcode, cycles) (cycles)
+#endif
+
+struct OpStat {
+    uint64_t count;
+    uint64_t cycles;
+    uint32_t opcode;
+};
+
+struct OpGroup {
+    const char *table;
+    uint32_t index;
+    OpStat stat;
+};
+
+FORCE_INLINE int countOp(OpStat &stat, uint32_t opcode, int cycles) {
+    // Count an executed handler and its cycles, remembering the opcode as an example
+    stat.count++;
+    stat.cycles += cycles;
+    stat.opcode = opcode;
+    return cycles;
+}
+
+template <typename T> void groupOps(std::vector<OpGroup> &groups, const char *table,
+        const OpStat *stats, T *handlers, uint32_t size) {
+    // Merge the counters of table entries that share a handler, labeling each by its first entry
+    size_t start = groups.size();
+    for (uint32_t i = 0; i < size; i++) {
+        if (!stats[i].count) continue;
+        size_t j = start;
+        while (j < groups.size() && handlers[groups[j].index] != handlers[i]) j++;
+        if (j == groups.size()) groups.push_back({ table, i, {} });
+        groups[j].stat.count += stats[i].count;
+        groups[j].stat.cycles += stats[i].cycles;
+        groups[j].stat.opcode = stats[i].opcode;
+    }
+}
+
+void writeOps(FILE *file, const char *name, std::vector<OpGroup> &groups);
@@ -0,0 +1,75 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "core.h"
+
+Profiler::Profiler(Core &core): core(core) {
+    // Set the sampling interval in ARM11 cycles, with zero disabling the profiler
+    interval = Settings::profileInterval;
+}
+
+void Profiler::sample() {
+    // Record where each ARM CPU is as a stack of its name, 3DS process, caller, and location
+    // Samples run as their own task, so CPUs are stopped between instructions exactly once per interval
+    static const char *names[] = { "ARM11 core 0", "ARM11 core 1", "ARM11 core 2", "ARM11 core 3", "ARM9" };
+    for (int i = 0; i < MAX_CPUS; i++) {
+        ArmInterp &cpu = core.arms[i];
+        std::string stack = names[i];
+        if (!cpu.halted) {
+            // Attribute ARM11 samples to the running process once the 3DS kernel is up
+            char name[9];
+            uint32_t process = core.cp15.getProcess(CpuId(i));
+            if (i != ARM9)
+                stack = stack + ";" + ((process && core.cp15.getProcName(CpuId(i), process, name)) ? name : "[no process]");
+
+            // Add the link register as the caller, since guest code has no reliable frame pointers
+            char frames[24];
+            uint32_t pc = cpu.registers[15] - ((cpu.cpsr & BIT(5)) ? 2 : 4);
+            sprintf(frames, ";0x%08X;0x%08X", cpu.registers[14] & ~0x1, pc);
+            stack += frames;
+        }
+        else {
+            stack += ";[halted]";
+        }
+        stacks[stack]++;
+    }
+
+    // Schedule the next sample
+    core.schedule(PROFILE_SAMPLE, interval);
+}
+
+void Profiler::restart() {
+    // Take the next sample an interval from now, replacing any that was pending or loaded from a state
+    core.cancel(PROFILE_SAMPLE);
+    if (interval)
+        core.schedule(PROFILE_SAMPLE, interval);
+}
+
+bool Profiler::write() {
+    // Open the profile file, replacing any previous one
+    if (!interval) return true;
+    FILE *file = fopen((Settings::basePath + "/profile.folded").c_str(), "w");
+    if (!file) return false;
+
+    // Write each unique stack with its sample count in folded format for flame graph tools
+    for (std::unordered_map<std::string, uint64_t>::iterator it = stacks.begin(); it != stacks.end(); it++)
+        fprintf(file, "%s %llu\n", it->first.c_str(), (unsigned long long)it->second);
+    fclose(file);
+    return true;
+}
@@ -23,11 +23,22 @@
 namespace Settings {
     int fpsLimiter = 1;
     int cartAutoBoot = 0;
+    int stateAutoLoad = 0;
     int dspBackend = 0;
+    int cpuTiming = 0;
+    int cpuBackend = 0;
+    int armHle = 0;
+    int fastMem = 0;
+    int profileInterval = 0;
+    int frameSkip = 0;
+    int threadedArm11 = 0;
+    int threadedArm9 = 0;
+    int threadedDsp = 0;
     int threadedGpu = 0;
     int gpuRenderer = 0;
     int gpuShader = 0;
     int unitType = 0;
+    int turboMode = 0; // Not saved
 
     std::string boot11Path = "boot11.bin";
     std::string boot9Path = "boot9.bin";
@@ -38,7 +49,17 @@ namespace Settings {
     std::vector<Setting> settings = {
         Setting("fpsLimiter", &fpsLimiter, false),
         Setting("cartAutoBoot", &cartAutoBoot, false),
+        Setting("stateAutoLoad", &stateAutoLoad, false),
         Setting("dspBackend", &dspBackend, false),
+        Setting("cpuTiming", &cpuTiming, false),
+        Setting("cpuBackend", &cpuBackend, false),
+        Setting("armHle", &armHle, false),
+        Setting("fastMem", &fastMem, false),
+        Setting("profileInterval", &profileInterval, false),
+        Setting("frameSkip", &frameSkip, false),
+        Setting("threadedArm11", &threadedArm11, false),
+        Setting("threadedArm9", &threadedArm9, false),
+        Setting("threadedDsp", &threadedDsp, false),
         Setting("threadedGpu", &threadedGpu, false),
         Setting("gpuRenderer", &gpuRenderer, false),
         Setting("gpuShader", &gpuShader, false),
@@ -34,11 +34,22 @@ struct Setting {
 namespace Settings {
     extern int fpsLimiter;
     extern int cartAutoBoot;
+    extern int stateAutoLoad;
     extern int dspBackend;
+    extern int cpuTiming;
+    extern int cpuBackend;
+    extern int armHle;
+    extern int fastMem;
+    extern int profileInterval;
+    extern int frameSkip;
+    extern int threadedArm11;
+    extern int threadedArm9;
+    extern int threadedDsp;
     extern int threadedGpu;
     extern int gpuRenderer;
     extern int gpuShader;
     extern int unitType;
+    extern int turboMode;
 
     extern std::string boot11Path;
     extern std::string boot9Path;
@@ -0,0 +1,56 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "state.h"
+
+void SaveState::data(void *data, size_t size) {
+    // Read or write raw bytes, remembering if the file came up short
+    if (failed) return;
+    if ((loading ? fread(data, 1, size, file) : fwrite(data, 1, size, file)) != size)
+        failed = true;
+}
+
+void SaveState::ram(uint8_t *data, size_t size) {
+    // Build a map of which 4KB pages hold anything but zeros when saving
+    size_t count = (size + 0xFFF) >> 12;
+    std::vector<uint8_t> used(count);
+    if (!loading) {
+        for (size_t i = 0; i < count; i++) {
+            uint64_t *page = (uint64_t*)&data[i << 12];
+            for (size_t j = 0; j < std::min<size_t>(size - (i << 12), 0x1000) >> 3 && !used[i]; j++)
+                used[i] = (page[j] != 0);
+        }
+    }
+
+    // Transfer the page map, then only the used pages, merging runs into single transfers
+    this->data(&used[0], count);
+    for (size_t i = 0; i < count;) {
+        size_t j = i;
+        while (j < count && used[j] == used[i]) j++;
+        size_t start = (i << 12), end = std::min<size_t>(j << 12, size);
+        if (used[i])
+            this->data(&data[start], end - start);
+        else if (loading)
+            memset(&data[start], 0, end - start);
+        i = j;
+    }
+}
@@ -0,0 +1,70 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <queue>
+#include <type_traits>
+
+class SaveState {
+public:
+    bool loading;
+
+    SaveState(FILE *file, bool loading): loading(loading), file(file) {}
+    bool ok() { return !failed; }
+
+    void data(void *data, size_t size);
+    void ram(uint8_t *data, size_t size);
+
+    template <typename T> void io(T &value);
+    template <typename T> void io(std::deque<T> &deque);
+    template <typename T> void io(std::queue<T> &queue);
+
+private:
+    FILE *file;
+    bool failed = false;
+};
+
+template <typename T> void SaveState::io(T &value) {
+    // Transfer a plain value or array as raw bytes
+    static_assert(std::is_trivially_copyable<T>::value, "State values must be plain data");
+    data(&value, sizeof(T));
+}
+
+template <typename T> void SaveState::io(std::deque<T> &deque) {
+    // Transfer a deque as its size followed by its elements
+    uint32_t size = deque.size();
+    io(size);
+    if (loading) deque.resize(size);
+    for (uint32_t i = 0; i < size; i++)
+        io(deque[i]);
+}
+
+template <typename T> void SaveState::io(std::queue<T> &queue) {
+    // Transfer a queue through a deque, since its elements can't be accessed in place
+    std::deque<T> copy;
+    if (!loading)
+        for (std::queue<T> temp = queue; !temp.empty(); temp.pop())
+            copy.push_back(temp.front());
+    io(copy);
+    if (loading) queue = std::queue<T>(copy);
+}
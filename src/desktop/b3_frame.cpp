@@ -30,10 +30,29 @@ enum FrameEvent {
     PAUSE,
     RESTART,
     STOP,
+    SAVE_STATE,
+    LOAD_STATE,
+    WRITE_OP_STATS,
+    TURBO_MODE,
     FPS_LIMITER,
     CART_AUTO_BOOT,
+    STATE_AUTO_LOAD,
     DSP_INTERP,
     DSP_HLE,
+    CPU_INTERP,
+    CPU_JIT,
+    CPU_CACHED,
+    CPU_LOCKSTEP,
+    CPU_QUANTUM64,
+    CPU_QUANTUM256,
+    CPU_QUANTUM1024,
+    SKIP_AUTO,
+    SKIP_2,
+    SKIP_4,
+    SKIP_8,
+    THREADED_ARM11,
+    THREADED_ARM9,
+    THREADED_DSP,
     THREADED_GPU,
     GPU_RENDER_SOFT,
     GPU_RENDER_OGL,
@@ -51,10 +70,31 @@ EVT_MENU(QUIT, b3Frame::quit)
 EVT_MENU(PAUSE, b3Frame::pause)
 EVT_MENU(RESTART, b3Frame::restart)
 EVT_MENU(STOP, b3Frame::stop)
+EVT_MENU(SAVE_STATE, b3Frame::saveState)
+EVT_MENU(LOAD_STATE, b3Frame::loadState)
+#if OP_STATS
+EVT_MENU(WRITE_OP_STATS, b3Frame::writeOpStats)
+#endif
+EVT_MENU(TURBO_MODE, b3Frame::turboMode)
 EVT_MENU(FPS_LIMITER, b3Frame::fpsLimiter)
 EVT_MENU(CART_AUTO_BOOT, b3Frame::cartAutoBoot)
+EVT_MENU(STATE_AUTO_LOAD, b3Frame::stateAutoLoad)
 EVT_MENU(DSP_INTERP, b3Frame::dspBackend<0>)
 EVT_MENU(DSP_HLE, b3Frame::dspBackend<1>)
+EVT_MENU(CPU_INTERP, b3Frame::cpuBackend<0>)
+EVT_MENU(CPU_JIT, b3Frame::cpuBackend<1>)
+EVT_MENU(CPU_CACHED, b3Frame::cpuBackend<2>)
+EVT_MENU(CPU_LOCKSTEP, b3Frame::cpuTiming<0>)
+EVT_MENU(CPU_QUANTUM64, b3Frame::cpuTiming<1>)
+EVT_MENU(CPU_QUANTUM256, b3Frame::cpuTiming<2>)
+EVT_MENU(CPU_QUANTUM1024, b3Frame::cpuTiming<3>)
+EVT_MENU(SKIP_AUTO, b3Frame::frameSkip<0>)
+EVT_MENU(SKIP_2, b3Frame::frameSkip<1>)
+EVT_MENU(SKIP_4, b3Frame::frameSkip<2>)
+EVT_MENU(SKIP_8, b3Frame::frameSkip<3>)
+EVT_MENU(THREADED_ARM11, b3Frame::threadedArm11)
+EVT_MENU(THREADED_ARM9, b3Frame::threadedArm9)
+EVT_MENU(THREADED_DSP, b3Frame::threadedDsp)
 EVT_MENU(THREADED_GPU, b3Frame::threadedGpu)
 EVT_MENU(GPU_RENDER_SOFT, b3Frame::gpuRenderer<0>)
 EVT_MENU(GPU_RENDER_OGL, b3Frame::gpuRenderer<1>)
@@ -80,12 +120,40 @@ b3Frame::b3Frame(): wxFrame(nullptr, wxID_ANY, "3Beans") {
     systemMenu->Append(PAUSE, "&Pause");
     systemMenu->Append(RESTART, "&Restart");
     systemMenu->Append(STOP, "&Stop");
+    systemMenu->AppendSeparator();
+    systemMenu->Append(SAVE_STATE, "Sa&ve State");
+    systemMenu->Append(LOAD_STATE, "&Load State");
+#if OP_STATS
+    systemMenu->Append(WRITE_OP_STATS, "&Write Handler Stats");
+#endif
+    systemMenu->AppendSeparator();
+    systemMenu->AppendCheckItem(TURBO_MODE, "&Turbo Mode");
 
     // Set up the DSP backend submenu
     wxMenu *dspMenu = new wxMenu();
     dspMenu->AppendRadioItem(DSP_INTERP, "&Interpreter");
     dspMenu->AppendRadioItem(DSP_HLE, "&HLE");
 
+    // Set up the ARM11 backend submenu
+    wxMenu *backendMenu = new wxMenu();
+    backendMenu->AppendRadioItem(CPU_INTERP, "&Interpreter");
+    backendMenu->AppendRadioItem(CPU_JIT, "&JIT");
+    backendMenu->AppendRadioItem(CPU_CACHED, "&Cached Interpreter");
+
+    // Set up the CPU timing submenu
+    wxMenu *cpuMenu = new wxMenu();
+    cpuMenu->AppendRadioItem(CPU_LOCKSTEP, "&Lockstep");
+    cpuMenu->AppendRadioItem(CPU_QUANTUM64, "&64-Cycle Slices");
+    cpuMenu->AppendRadioItem(CPU_QUANTUM256, "&256-Cycle Slices");
+    cpuMenu->AppendRadioItem(CPU_QUANTUM1024, "&1024-Cycle Slices");
+
+    // Set up the turbo frame skip submenu
+    wxMenu *skipMenu = new wxMenu();
+    skipMenu->AppendRadioItem(SKIP_AUTO, "&Automatic");
+    skipMenu->AppendRadioItem(SKIP_2, "Every &2nd Frame");
+    skipMenu->AppendRadioItem(SKIP_4, "Every &4th Frame");
+    skipMenu->AppendRadioItem(SKIP_8, "Every &8th Frame");
+
     // Set up the GPU renderer submenu
     wxMenu *renderMenu = new wxMenu();
     renderMenu->AppendRadioItem(GPU_RENDER_SOFT, "&Software");
@@ -100,7 +168,14 @@ b3Frame::b3Frame(): wxFrame(nullptr, wxID_ANY, "3Beans") {
     wxMenu *settingsMenu = new wxMenu();
     settingsMenu->AppendCheckItem(FPS_LIMITER, "&FPS Limiter");
     settingsMenu->AppendCheckItem(CART_AUTO_BOOT, "&Cart Auto-Boot");
+    settingsMenu->AppendCheckItem(STATE_AUTO_LOAD, "&State Auto-Load");
     settingsMenu->AppendSubMenu(dspMenu, "&DSP Backend");
+    settingsMenu->AppendSubMenu(backendMenu, "&ARM11 Backend");
+    settingsMenu->AppendSubMenu(cpuMenu, "&CPU Timing");
+    settingsMenu->AppendSubMenu(skipMenu, "Turbo &Frame Skip");
+    settingsMenu->AppendCheckItem(THREADED_ARM11, "&Threaded ARM11");
+    settingsMenu->AppendCheckItem(THREADED_ARM9, "Threaded ARM&9");
+    settingsMenu->AppendCheckItem(THREADED_DSP, "Threaded &DSP");
     settingsMenu->AppendSeparator();
     settingsMenu->AppendCheckItem(THREADED_GPU, "&Threaded GPU");
     settingsMenu->AppendSubMenu(renderMenu, "&GPU Renderer");
@@ -153,7 +228,14 @@ b3Frame::b3Frame(): wxFrame(nullptr, wxID_ANY, "3Beans") {
     // Set the initial setting states
     settingsMenu->Check(FPS_LIMITER, Settings::fpsLimiter);
     settingsMenu->Check(CART_AUTO_BOOT, Settings::cartAutoBoot);
+    settingsMenu->Check(STATE_AUTO_LOAD, Settings::stateAutoLoad);
     dspMenu->Check(DSP_INTERP + std::min(Settings::dspBackend, 1), true);
+    backendMenu->Check(CPU_INTERP + std::min(Settings::cpuBackend, 2), true);
+    cpuMenu->Check(CPU_LOCKSTEP + std::min(Settings::cpuTiming, 3), true);
+    skipMenu->Check(SKIP_AUTO + std::min(Settings::frameSkip, 3), true);
+    settingsMenu->Check(THREADED_ARM11, Settings::threadedArm11);
+    settingsMenu->Check(THREADED_ARM9, Settings::threadedArm9);
+    settingsMenu->Check(THREADED_DSP, Settings::threadedDsp);
     settingsMenu->Check(THREADED_GPU, Settings::threadedGpu);
     renderMenu->Check(GPU_RENDER_SOFT + std::min(Settings::gpuRenderer, 1), true);
     shaderMenu->Check(GPU_SHADER_INTERP + std::min(Settings::gpuShader, 1), true);
@@ -211,6 +293,10 @@ void b3Frame::startCore(bool full) {
                 "Boot ROMs Missing", wxICON_NONE).ShowModal();
             return;
         }
+
+        // Skip the boot process by restoring a saved state if enabled
+        if (Settings::stateAutoLoad)
+            core->loadState(statePath());
     }
 
     // Update the resting axis values so relative offsets can be taken
@@ -228,6 +314,11 @@ void b3Frame::startCore(bool full) {
     systemMenu->SetLabel(RESTART, "&Restart");
     systemMenu->Enable(PAUSE, true);
     systemMenu->Enable(STOP, true);
+    systemMenu->Enable(SAVE_STATE, true);
+    systemMenu->Enable(LOAD_STATE, true);
+#if OP_STATS
+    systemMenu->Enable(WRITE_OP_STATS, true);
+#endif
 }
 
 void b3Frame::stopCore(bool full) {
@@ -244,6 +335,11 @@ void b3Frame::stopCore(bool full) {
     systemMenu->SetLabel(RESTART, "&Start");
     systemMenu->Enable(PAUSE, false);
     systemMenu->Enable(STOP, false);
+    systemMenu->Enable(SAVE_STATE, false);
+    systemMenu->Enable(LOAD_STATE, false);
+#if OP_STATS
+    systemMenu->Enable(WRITE_OP_STATS, false);
+#endif
 
     // Fully stop and remove the core
     mutex.lock();
@@ -254,6 +350,12 @@ void b3Frame::stopCore(bool full) {
     mutex.unlock();
 }
 
+std::string b3Frame::statePath() {
+    // Keep states next to the cart ROM, or in the base folder when booting without one
+    if (cartPath.empty()) return Settings::basePath + "/boot.b3s";
+    return cartPath.substr(0, cartPath.rfind('.')) + ".b3s";
+}
+
 uint32_t *b3Frame::getFrame() {
     // Track refresh rate and update the swap interval every second
     refreshRate++;
@@ -389,6 +491,43 @@ void b3Frame::stop(wxCommandEvent &event) {
     stopCore(true);
 }
 
+void b3Frame::saveState(wxCommandEvent &event) {
+    // Pause the core and write its state to a file
+    bool resume = running.load();
+    stopCore(false);
+    if (!core->saveState(statePath()))
+        wxMessageDialog(this, "The state file couldn't be written.", "Save State Failed", wxICON_NONE).ShowModal();
+    if (resume) startCore(false);
+}
+
+void b3Frame::loadState(wxCommandEvent &event) {
+    // Pause the core and restore its state from a file, restarting if the file is incomplete
+    bool resume = running.load();
+    stopCore(false);
+    if (!core->loadState(statePath())) {
+        wxMessageDialog(this, "The state file is missing, incomplete, or from a different setup or modified files.",
+            "Load State Failed", wxICON_NONE).ShowModal();
+        return startCore(true);
+    }
+    if (resume) startCore(false);
+}
+
+#if OP_STATS
+void b3Frame::writeOpStats(wxCommandEvent &event) {
+    // Pause the core and write a report of executed handlers to a file
+    bool resume = running.load();
+    stopCore(false);
+    if (!core->writeOpStats())
+        wxMessageDialog(this, "The handler report couldn't be written.", "Write Stats Failed", wxICON_NONE).ShowModal();
+    if (resume) startCore(false);
+}
+#endif
+
+void b3Frame::turboMode(wxCommandEvent &event) {
+    // Toggle turbo mode, which takes effect right away and isn't saved
+    Settings::turboMode = !Settings::turboMode;
+}
+
 void b3Frame::fpsLimiter(wxCommandEvent &event) {
     // Toggle the FPS limiter setting
     Settings::fpsLimiter = !Settings::fpsLimiter;
@@ -401,12 +540,54 @@ void b3Frame::cartAutoBoot(wxCommandEvent &event) {
     Settings::save();
 }
 
+void b3Frame::stateAutoLoad(wxCommandEvent &event) {
+    // Toggle the state auto-load setting
+    Settings::stateAutoLoad = !Settings::stateAutoLoad;
+    Settings::save();
+}
+
 template <int i> void b3Frame::dspBackend(wxCommandEvent &event) {
     // Set the DSP backend to a specific value
     Settings::dspBackend = i;
     Settings::save();
 }
 
+template <int i> void b3Frame::cpuBackend(wxCommandEvent &event) {
+    // Set the ARM11 backend to a specific value
+    Settings::cpuBackend = i;
+    Settings::save();
+}
+
+template <int i> void b3Frame::cpuTiming(wxCommandEvent &event) {
+    // Set the CPU timing to a specific value
+    Settings::cpuTiming = i;
+    Settings::save();
+}
+
+template <int i> void b3Frame::frameSkip(wxCommandEvent &event) {
+    // Set the turbo frame skip to a specific value
+    Settings::frameSkip = i;
+    Settings::save();
+}
+
+void b3Frame::threadedArm11(wxCommandEvent &event) {
+    // Toggle the threaded ARM11 setting
+    Settings::threadedArm11 = !Settings::threadedArm11;
+    Settings::save();
+}
+
+void b3Frame::threadedArm9(wxCommandEvent &event) {
+    // Toggle the threaded ARM9 setting
+    Settings::threadedArm9 = !Settings::threadedArm9;
+    Settings::save();
+}
+
+void b3Frame::threadedDsp(wxCommandEvent &event) {
+    // Toggle the threaded DSP setting
+    Settings::threadedDsp = !Settings::threadedDsp;
+    Settings::save();
+}
+
 void b3Frame::threadedGpu(wxCommandEvent &event) {
     // Toggle the threaded GPU setting
     Settings::threadedGpu = !Settings::threadedGpu;
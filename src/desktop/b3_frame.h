@@ -63,6 +63,7 @@ private:
     void runCore();
     void startCore(bool full);
     void stopCore(bool full);
+    std::string statePath();
     void updateKeyStick();
 
     void insertCart(wxCommandEvent &event);
@@ -71,9 +72,22 @@ private:
     void pause(wxCommandEvent &event);
     void restart(wxCommandEvent &event);
     void stop(wxCommandEvent &event);
+    void saveState(wxCommandEvent &event);
+    void loadState(wxCommandEvent &event);
+#if OP_STATS
+    void writeOpStats(wxCommandEvent &event);
+#endif
+    void turboMode(wxCommandEvent &event);
     void fpsLimiter(wxCommandEvent &event);
     void cartAutoBoot(wxCommandEvent &event);
+    void stateAutoLoad(wxCommandEvent &event);
     template <int i> void dspBackend(wxCommandEvent &event);
+    template <int i> void cpuBackend(wxCommandEvent &event);
+    template <int i> void cpuTiming(wxCommandEvent &event);
+    template <int i> void frameSkip(wxCommandEvent &event);
+    void threadedArm11(wxCommandEvent &event);
+    void threadedArm9(wxCommandEvent &event);
+    void threadedDsp(wxCommandEvent &event);
     void threadedGpu(wxCommandEvent &event);
     template <int i> void gpuRenderer(wxCommandEvent &event);
     template <int i> void gpuShader(wxCommandEvent &event);
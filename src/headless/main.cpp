@@ -0,0 +1,130 @@
+/*
+    Copyright 2023-2026 Hydr8gon
+
+    This file is part of 3Beans.
+
+    3Beans is free software: you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    3Beans is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+    General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with 3Beans. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../core/core.h"
+
+static const char *usage =
+    "Usage: 3beans-headless [options] [cart]\n"
+    "  -f, --frames N     Run N frames (default 600)\n"
+    "  -s, --seconds N    Run N emulated seconds\n"
+    "  -c, --config DIR   Load 3beans.ini from DIR (default .)\n"
+    "  -l, --load FILE    Load a save state before running\n"
+    "  -w, --save FILE    Write a save state after running\n"
+    "  -p, --profile N    Sample guest PCs every N cycles to profile.folded\n";
+
+int main(int argc, char **argv) {
+    // Parse the command line arguments
+    std::string cartPath, configDir = ".", loadPath, savePath;
+    int frames = 600, profile = 0;
+    for (int i = 1; i < argc; i++) {
+        if ((!strcmp(argv[i], "-f") || !strcmp(argv[i], "--frames")) && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        }
+        else if ((!strcmp(argv[i], "-s") || !strcmp(argv[i], "--seconds")) && i + 1 < argc) {
+            frames = atoi(argv[++i]) * 60;
+        }
+        else if ((!strcmp(argv[i], "-c") || !strcmp(argv[i], "--config")) && i + 1 < argc) {
+            configDir = argv[++i];
+        }
+        else if ((!strcmp(argv[i], "-l") || !strcmp(argv[i], "--load")) && i + 1 < argc) {
+            loadPath = argv[++i];
+        }
+        else if ((!strcmp(argv[i], "-w") || !strcmp(argv[i], "--save")) && i + 1 < argc) {
+            savePath = argv[++i];
+        }
+        else if ((!strcmp(argv[i], "-p") || !strcmp(argv[i], "--profile")) && i + 1 < argc) {
+            profile = atoi(argv[++i]);
+        }
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "%s", usage);
+            return 1;
+        }
+        else {
+            cartPath = argv[i];
+        }
+    }
+
+    // Load settings, but force the software renderer and run unthrottled without a display
+    Settings::load(configDir);
+    Settings::fpsLimiter = 0;
+    Settings::gpuRenderer = 0;
+    Settings::gpuShader = 0;
+    if (profile) Settings::profileInterval = profile;
+
+    // Create the core without a GL context
+    Core *core;
+    try {
+        core = new Core(cartPath);
+    }
+    catch (CoreError e) {
+        fprintf(stderr, "One of the boot ROMs is missing! Check the paths in 3beans.ini.\n");
+        return 1;
+    }
+
+    // Restore a save state to skip the boot process if requested
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!loadPath.empty() && !core->loadState(loadPath)) {
+        fprintf(stderr, "Failed to load save state %s\n", loadPath.c_str());
+        delete core;
+        return 1;
+    }
+    double load = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Run the frames, consuming output as a frontend would
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        core->runFrame();
+        while (uint32_t *fb = core->pdc.getFrame())
+            delete[] fb;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Write a save state for later runs if requested
+    if (!savePath.empty() && !core->saveState(savePath))
+        fprintf(stderr, "Failed to write save state %s\n", savePath.c_str());
+
+    // Gather instruction counts for each CPU
+    static const char *names[] = { "arm11a", "arm11b", "arm11c", "arm11d", "arm9", "teak" };
+    uint64_t counts[MAX_CPUS + 1];
+    for (int i = 0; i < MAX_CPUS; i++)
+        counts[i] = core->arms[i].instructions;
+    counts[MAX_CPUS] = (Settings::dspBackend == 1) ? 0 : ((DspLle*)core->dsp)->teak.instructions;
+
+    // Print the results as JSON, clamping the time so rates stay finite for very short runs
+    double rate = std::max(wall, 1e-6);
+    printf("{\n");
+    printf("  \"frames\": %d,\n", frames);
+    printf("  \"emulated_seconds\": %.3f,\n", frames / 60.0);
+    printf("  \"wall_seconds\": %.3f,\n", wall);
+    printf("  \"state_load_seconds\": %.3f,\n", load);
+    printf("  \"emulated_fps\": %.2f,\n", frames / rate);
+    printf("  \"instructions_per_second\": {\n");
+    for (int i = 0; i <= MAX_CPUS; i++)
+        printf("    \"%s\": %.0f%s\n", names[i], counts[i] / rate, (i < MAX_CPUS) ? "," : "");
+    printf("  }\n}\n");
+
+    delete core;
+    return 0;
+}